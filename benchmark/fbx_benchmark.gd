@@ -0,0 +1,127 @@
+# Headless FBX import benchmark.
+#
+# Imports every file of a corpus with profiling enabled and generates its scene,
+# writes the profiles as JSON and, given a baseline written by an earlier run,
+# exits with code 1 when FBXState.compare_profile() reports a regression for any
+# file.
+#
+#   godot --headless --path <project> -s <path to>/fbx_benchmark.gd -- \
+#       --corpus=corpus.txt --output=profile.json [--baseline=baseline.json] \
+#       [--tolerance=0.1] [--iterations=3] [--detailed]
+#
+# --corpus     Text file listing the files to import, see corpus.txt. Extra
+#              positional arguments are imported as well.
+# --output     Where the profiles are written: a JSON object mapping each file
+#              to the entries of FBXState.get_profile(). Use it as the next
+#              --baseline.
+# --baseline   Output of an earlier run to compare against.
+# --tolerance  Allowed growth before a stage counts as a regression, 0.1 is 10%.
+# --iterations Imports of each file, the fastest one is kept to reduce noise.
+# --detailed   Also records an entry per mesh and animation.
+#
+# Exit codes: 0 without regressions, 1 with regressions, 2 when the arguments
+# are invalid or a file fails to import.
+extends SceneTree
+
+const EXIT_OK = 0
+const EXIT_REGRESSION = 1
+const EXIT_ERROR = 2
+
+
+func _initialize() -> void:
+	quit(_run())
+
+
+func _run() -> int:
+	var options := {
+		"corpus": "",
+		"output": "",
+		"baseline": "",
+		"tolerance": "0.1",
+		"iterations": "1",
+	}
+	var detailed := false
+	var paths := PackedStringArray()
+	for arg in OS.get_cmdline_user_args():
+		if arg == "--detailed":
+			detailed = true
+		elif arg.begins_with("--") and arg.contains("="):
+			var key: String = arg.substr(2, arg.find("=") - 2)
+			if not options.has(key):
+				printerr("Unknown option: ", arg)
+				return EXIT_ERROR
+			options[key] = arg.substr(arg.find("=") + 1)
+		else:
+			paths.push_back(arg)
+
+	if not options["corpus"].is_empty():
+		var corpus := FileAccess.open(options["corpus"], FileAccess.READ)
+		if corpus == null:
+			printerr("Can't open the corpus: ", options["corpus"])
+			return EXIT_ERROR
+		while not corpus.eof_reached():
+			var line: String = corpus.get_line().strip_edges()
+			if not line.is_empty() and not line.begins_with("#"):
+				paths.push_back(line)
+	if paths.is_empty() or options["output"].is_empty():
+		printerr("Usage: fbx_benchmark.gd -- --corpus=<file> --output=<json> [--baseline=<json>] [--tolerance=<fraction>] [--iterations=<count>] [--detailed] [files...]")
+		return EXIT_ERROR
+
+	var iterations := maxi(int(options["iterations"]), 1)
+	var states := {}
+	for path in paths:
+		var best_state: FBXState = null
+		for iteration in iterations:
+			var state := FBXState.new()
+			state.profiling_enabled = true
+			state.detailed_profiling = detailed
+			var document := FBXDocument.new()
+			var err: Error = document.append_from_file(path, state)
+			if err != OK:
+				printerr("Failed to import ", path, ": ", error_string(err))
+				return EXIT_ERROR
+			# Generating the scene covers the mesh instances, animations and extension hooks too.
+			var root := document.generate_scene(state)
+			if root == null:
+				printerr("Failed to generate the scene of ", path)
+				return EXIT_ERROR
+			root.free()
+			if best_state == null or _get_stage_duration(state) < _get_stage_duration(best_state):
+				best_state = state
+		states[path] = best_state
+		print("%s: %.2f ms" % [path, _get_stage_duration(best_state) / 1000.0])
+
+	var profiles := {}
+	for path in states:
+		profiles[path] = states[path].get_profile()
+	var output := FileAccess.open(options["output"], FileAccess.WRITE)
+	if output == null:
+		printerr("Can't write the profiles to: ", options["output"])
+		return EXIT_ERROR
+	output.store_string(JSON.stringify(profiles, "\t"))
+	output.close()
+
+	if options["baseline"].is_empty():
+		return EXIT_OK
+	var baseline = JSON.parse_string(FileAccess.get_file_as_string(options["baseline"]))
+	if typeof(baseline) != TYPE_DICTIONARY:
+		printerr("The baseline must be the output of an earlier run: ", options["baseline"])
+		return EXIT_ERROR
+	var ret := EXIT_OK
+	for path in states:
+		if not baseline.has(path):
+			print("%s: not in the baseline, skipped" % path)
+			continue
+		for regression in states[path].compare_profile(JSON.stringify(baseline[path]), float(options["tolerance"])):
+			printerr("%s: %s" % [path, regression])
+			ret = EXIT_REGRESSION
+	return ret
+
+
+# Total duration of the "stage" entries, which are the ones compare_profile() looks at.
+func _get_stage_duration(state: FBXState) -> int:
+	var duration := 0
+	for entry in state.get_profile():
+		if entry["category"] == "stage":
+			duration += int(entry["duration_usec"])
+	return duration
@@ -35,9 +35,21 @@
 #include "../fbx_document.h"
 
 #include "core/config/project_settings.h"
+#include "core/os/thread.h"
+#include "editor/editor_node.h"
 #include "editor/editor_settings.h"
 #include "main/main.h"
 
+static const int IMPORT_PROGRESS_STEPS = 1000;
+
+bool EditorSceneFormatImporterUFBX::_import_progress(const String &p_stage, float p_progress) {
+	if (!import_progress) {
+		return true;
+	}
+	// Returning false cancels the import.
+	return !import_progress->step(p_stage, int(p_progress * IMPORT_PROGRESS_STEPS), false);
+}
+
 uint32_t EditorSceneFormatImporterUFBX::get_import_flags() const {
 	return ImportFlags::IMPORT_SCENE | ImportFlags::IMPORT_ANIMATION;
 }
@@ -55,31 +67,117 @@ Node *EditorSceneFormatImporterUFBX::import_scene(const String &p_path, uint32_t
 	Ref<FBXState> state;
 	state.instantiate();
 	print_verbose(vformat("glTF path: %s", p_path));
+	if (p_options.has("animation/fps")) {
+		state->set_bake_fps(p_options["animation/fps"]);
+	}
+	if (p_options.has("fbx/animation/key_reduction")) {
+		state->set_bake_key_reduction(p_options["fbx/animation/key_reduction"]);
+	}
+	if (p_options.has("fbx/animation/key_reduction_rotation")) {
+		state->set_bake_key_reduction_rotation(p_options["fbx/animation/key_reduction_rotation"]);
+	}
+	if (p_options.has("fbx/animation/key_reduction_threshold")) {
+		state->set_bake_key_reduction_threshold(p_options["fbx/animation/key_reduction_threshold"]);
+	}
+	if (p_options.has("fbx/animation/key_reduction_passes")) {
+		state->set_bake_key_reduction_passes(p_options["fbx/animation/key_reduction_passes"]);
+	}
+	if (p_options.has("fbx/animation/max_keyframe_segments")) {
+		state->set_bake_max_keyframe_segments(p_options["fbx/animation/max_keyframe_segments"]);
+	}
+	if (!p_options.has("fbx/cache") || bool(p_options["fbx/cache"])) {
+		// Lets option-only reimports reuse the meshes and baked animations of unchanged sources.
+		state->set_cache_path(ProjectSettings::get_singleton()->globalize_path(ProjectSettings::get_singleton()->get_project_data_path().path_join("fbx_cache")));
+	}
+	if (p_options.has("fbx/animation/compress")) {
+		state->set_compress_animations(p_options["fbx/animation/compress"]);
+	}
+	if (p_options.has("fbx/animation/compression_page_size")) {
+		state->set_animation_compression_page_size(p_options["fbx/animation/compression_page_size"]);
+	}
+	if (p_options.has("fbx/meshes/compress_vertex_attributes")) {
+		state->set_compress_vertex_attributes(p_options["fbx/meshes/compress_vertex_attributes"]);
+	}
+	if (p_options.has("fbx/meshes/vertex_compression_max_error")) {
+		state->set_vertex_compression_max_error(p_options["fbx/meshes/vertex_compression_max_error"]);
+	}
+	if (p_options.has("fbx/meshes/multimesh_instance_threshold")) {
+		state->set_multimesh_instance_threshold(p_options["fbx/meshes/multimesh_instance_threshold"]);
+	}
+	// Skip loading the animation curves entirely when the animations aren't imported.
+	state->set_import_animations(p_flags & EditorSceneFormatImporter::IMPORT_ANIMATION);
+	// Only the generated scene is kept, so the ufbx scene can go before the nodes are built.
+	state->set_release_scene_data(true);
+
+	// The progress dialog can only be driven from the main thread.
+	EditorProgress *prev_progress = import_progress;
+	EditorProgress *progress = nullptr;
+	if (Thread::is_main_thread()) {
+		progress = memnew(EditorProgress("import_fbx", vformat(TTR("Importing FBX: %s"), p_path.get_file()), IMPORT_PROGRESS_STEPS, true));
+		import_progress = progress;
+		gltf->set_progress_callback(callable_mp(this, &EditorSceneFormatImporterUFBX::_import_progress));
+	}
+
 	String path = ProjectSettings::get_singleton()->globalize_path(p_path);
 	Error err = gltf->append_from_file(path, state, p_flags, p_path.get_base_dir());
+	Node *root = nullptr;
+	if (err == OK) {
+#ifndef DISABLE_DEPRECATED
+		bool trimming = p_options.has("animation/trimming") ? (bool)p_options["animation/trimming"] : false;
+		bool remove_immutable = p_options.has("animation/remove_immutable_tracks") ? (bool)p_options["animation/remove_immutable_tracks"] : true;
+		root = gltf->generate_scene(state, (float)p_options["animation/fps"], trimming, remove_immutable);
+#else
+		root = gltf->generate_scene(state, (float)p_options["animation/fps"], (bool)p_options["animation/trimming"], (bool)p_options["animation/remove_immutable_tracks"]);
+#endif
+	}
+
+	if (progress) {
+		memdelete(progress);
+	}
+	import_progress = prev_progress;
+
 	if (err != OK) {
 		if (r_err) {
-			*r_err = FAILED;
+			*r_err = err == ERR_SKIP ? ERR_SKIP : FAILED;
 		}
 		return nullptr;
 	}
-
-#ifndef DISABLE_DEPRECATED
-	bool trimming = p_options.has("animation/trimming") ? (bool)p_options["animation/trimming"] : false;
-	bool remove_immutable = p_options.has("animation/remove_immutable_tracks") ? (bool)p_options["animation/remove_immutable_tracks"] : true;
-	return gltf->generate_scene(state, (float)p_options["animation/fps"], trimming, remove_immutable);
-#else
-	return gltf->generate_scene(state, (float)p_options["animation/fps"], (bool)p_options["animation/trimming"], (bool)p_options["animation/remove_immutable_tracks"]);
-#endif
+	return root;
 }
 
 Variant EditorSceneFormatImporterUFBX::get_option_visibility(const String &p_path, bool p_for_animation,
 		const String &p_option, const HashMap<StringName, Variant> &p_options) {
+	if (p_option.begins_with("fbx/") && p_path.get_extension().to_lower() != "fbx") {
+		return false;
+	}
+	if (p_option == "fbx/meshes/vertex_compression_max_error" && p_options.has("fbx/meshes/compress_vertex_attributes") && !bool(p_options["fbx/meshes/compress_vertex_attributes"])) {
+		return false;
+	}
+	if (p_option == "fbx/animation/compression_page_size" && p_options.has("fbx/animation/compress") && !bool(p_options["fbx/animation/compress"])) {
+		return false;
+	}
+	if (p_option.begins_with("fbx/animation/key_reduction_") && p_options.has("fbx/animation/key_reduction") && !bool(p_options["fbx/animation/key_reduction"])) {
+		return false;
+	}
 	return true;
 }
 
 void EditorSceneFormatImporterUFBX::get_import_options(const String &p_path,
 		List<ResourceImporter::ImportOption> *r_options) {
+	if (!p_path.is_empty() && p_path.get_extension().to_lower() != "fbx") {
+		return;
+	}
+	r_options->push_back(ResourceImporterScene::ImportOption(PropertyInfo(Variant::BOOL, "fbx/cache"), true));
+	r_options->push_back(ResourceImporterScene::ImportOption(PropertyInfo(Variant::BOOL, "fbx/meshes/compress_vertex_attributes"), false));
+	r_options->push_back(ResourceImporterScene::ImportOption(PropertyInfo(Variant::FLOAT, "fbx/meshes/vertex_compression_max_error", PROPERTY_HINT_RANGE, "0,0.1,0.00001,or_greater,suffix:m"), 0.001));
+	r_options->push_back(ResourceImporterScene::ImportOption(PropertyInfo(Variant::INT, "fbx/meshes/multimesh_instance_threshold", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"), 0));
+	r_options->push_back(ResourceImporterScene::ImportOption(PropertyInfo(Variant::BOOL, "fbx/animation/key_reduction"), false));
+	r_options->push_back(ResourceImporterScene::ImportOption(PropertyInfo(Variant::BOOL, "fbx/animation/key_reduction_rotation"), false));
+	r_options->push_back(ResourceImporterScene::ImportOption(PropertyInfo(Variant::FLOAT, "fbx/animation/key_reduction_threshold", PROPERTY_HINT_RANGE, "0,0.01,0.000001,or_greater"), 0.000001));
+	r_options->push_back(ResourceImporterScene::ImportOption(PropertyInfo(Variant::INT, "fbx/animation/key_reduction_passes", PROPERTY_HINT_RANGE, "1,16,1"), 4));
+	r_options->push_back(ResourceImporterScene::ImportOption(PropertyInfo(Variant::INT, "fbx/animation/max_keyframe_segments", PROPERTY_HINT_RANGE, "1,256,1,or_greater"), 32));
+	r_options->push_back(ResourceImporterScene::ImportOption(PropertyInfo(Variant::BOOL, "fbx/animation/compress"), false));
+	r_options->push_back(ResourceImporterScene::ImportOption(PropertyInfo(Variant::INT, "fbx/animation/compression_page_size", PROPERTY_HINT_RANGE, "4,512,1,suffix:kb"), 8));
 }
 
 #endif // TOOLS_ENABLED
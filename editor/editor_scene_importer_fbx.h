@@ -38,11 +38,15 @@
 #include "editor/import/resource_importer_scene.h"
 
 class Animation;
+class EditorProgress;
 class Node;
 
 class EditorSceneFormatImporterUFBX : public EditorSceneFormatImporter {
 	GDCLASS(EditorSceneFormatImporterUFBX, EditorSceneFormatImporter);
 
+	EditorProgress *import_progress = nullptr;
+	bool _import_progress(const String &p_stage, float p_progress);
+
 public:
 	virtual uint32_t get_import_flags() const override;
 	virtual void get_extensions(List<String> *r_extensions) const override;
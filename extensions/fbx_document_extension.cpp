@@ -42,6 +42,49 @@ void FBXDocumentExtension::_bind_methods() {
 	GDVIRTUAL_BIND(_import_post_parse, "state");
 	GDVIRTUAL_BIND(_import_node, "state", "fbx_node", "json", "node");
 	GDVIRTUAL_BIND(_import_post, "state", "root");
+	GDVIRTUAL_BIND(_get_implemented_hooks);
+	GDVIRTUAL_BIND(_parse_nodes, "state", "fbx_nodes");
+	GDVIRTUAL_BIND(_generate_scene_nodes, "state", "fbx_nodes");
+	GDVIRTUAL_BIND(_import_nodes, "state", "node_indices", "nodes");
+
+	BIND_CONSTANT(HOOK_PARSE_NODE_EXTENSIONS);
+	BIND_CONSTANT(HOOK_GENERATE_SCENE_NODE);
+	BIND_CONSTANT(HOOK_IMPORT_NODE);
+	BIND_CONSTANT(HOOK_PARSE_NODES);
+	BIND_CONSTANT(HOOK_GENERATE_SCENE_NODES);
+	BIND_CONSTANT(HOOK_IMPORT_NODES);
+}
+
+uint32_t FBXDocumentExtension::get_implemented_hooks() {
+	uint32_t ret = 0;
+	if (GDVIRTUAL_CALL(_get_implemented_hooks, ret)) {
+		return ret;
+	}
+	if (!get_script_instance() && !_get_extension()) {
+		// Overrides of the C++ methods can't be detected, so native subclasses keep getting every
+		// per-node hook. They only get the bulk hooks by overriding this method.
+		return HOOK_PARSE_NODE_EXTENSIONS | HOOK_GENERATE_SCENE_NODE | HOOK_IMPORT_NODE;
+	}
+	// Without an explicit answer, only the hooks a script or GDExtension overrides are called.
+	if (GDVIRTUAL_IS_OVERRIDDEN(_parse_node_extensions)) {
+		ret |= HOOK_PARSE_NODE_EXTENSIONS;
+	}
+	if (GDVIRTUAL_IS_OVERRIDDEN(_generate_scene_node)) {
+		ret |= HOOK_GENERATE_SCENE_NODE;
+	}
+	if (GDVIRTUAL_IS_OVERRIDDEN(_import_node)) {
+		ret |= HOOK_IMPORT_NODE;
+	}
+	if (GDVIRTUAL_IS_OVERRIDDEN(_parse_nodes)) {
+		ret |= HOOK_PARSE_NODES;
+	}
+	if (GDVIRTUAL_IS_OVERRIDDEN(_generate_scene_nodes)) {
+		ret |= HOOK_GENERATE_SCENE_NODES;
+	}
+	if (GDVIRTUAL_IS_OVERRIDDEN(_import_nodes)) {
+		ret |= HOOK_IMPORT_NODES;
+	}
+	return ret;
 }
 
 // Import process.
@@ -120,3 +163,25 @@ Error FBXDocumentExtension::import_post(Ref<FBXState> p_state, Node *p_root) {
 	GDVIRTUAL_CALL(_import_post, p_state, p_root, err);
 	return err;
 }
+
+Error FBXDocumentExtension::parse_nodes(Ref<FBXState> p_state, const TypedArray<FBXNode> &p_fbx_nodes) {
+	ERR_FAIL_NULL_V(p_state, ERR_INVALID_PARAMETER);
+	Error err = OK;
+	GDVIRTUAL_CALL(_parse_nodes, p_state, p_fbx_nodes, err);
+	return err;
+}
+
+Dictionary FBXDocumentExtension::generate_scene_nodes(Ref<FBXState> p_state, const TypedArray<FBXNode> &p_fbx_nodes) {
+	ERR_FAIL_NULL_V(p_state, Dictionary());
+	Dictionary ret;
+	GDVIRTUAL_CALL(_generate_scene_nodes, p_state, p_fbx_nodes, ret);
+	return ret;
+}
+
+Error FBXDocumentExtension::import_nodes(Ref<FBXState> p_state, const PackedInt32Array &p_node_indices, const TypedArray<Node> &p_nodes) {
+	ERR_FAIL_NULL_V(p_state, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(p_node_indices.size() != p_nodes.size(), ERR_INVALID_PARAMETER);
+	Error err = OK;
+	GDVIRTUAL_CALL(_import_nodes, p_state, p_node_indices, p_nodes, err);
+	return err;
+}
@@ -40,6 +40,18 @@ protected:
 	static void _bind_methods();
 
 public:
+	// Per-node and bulk hooks, see `get_implemented_hooks()`.
+	enum FBXImportHook {
+		HOOK_PARSE_NODE_EXTENSIONS = 1 << 0,
+		HOOK_GENERATE_SCENE_NODE = 1 << 1,
+		HOOK_IMPORT_NODE = 1 << 2,
+		HOOK_PARSE_NODES = 1 << 3,
+		HOOK_GENERATE_SCENE_NODES = 1 << 4,
+		HOOK_IMPORT_NODES = 1 << 5,
+	};
+
+	virtual uint32_t get_implemented_hooks();
+
 	// Import process.
 	virtual Error import_preflight(Ref<FBXState> p_state, Vector<String> p_extensions);
 	virtual Vector<String> get_supported_extensions();
@@ -52,6 +64,11 @@ public:
 	virtual Error import_node(Ref<FBXState> p_state, Ref<FBXNode> p_gltf_node, Dictionary &r_json, Node *p_node);
 	virtual Error import_post(Ref<FBXState> p_state, Node *p_node);
 
+	// Bulk variants, called once with every node instead of once per node.
+	virtual Error parse_nodes(Ref<FBXState> p_state, const TypedArray<FBXNode> &p_fbx_nodes);
+	virtual Dictionary generate_scene_nodes(Ref<FBXState> p_state, const TypedArray<FBXNode> &p_fbx_nodes);
+	virtual Error import_nodes(Ref<FBXState> p_state, const PackedInt32Array &p_node_indices, const TypedArray<Node> &p_nodes);
+
 	// Import process.
 	GDVIRTUAL2R(Error, _import_preflight, Ref<FBXState>, Vector<String>);
 	GDVIRTUAL0R(Vector<String>, _get_supported_extensions);
@@ -63,6 +80,10 @@ public:
 	GDVIRTUAL1R(Error, _import_post_parse, Ref<FBXState>);
 	GDVIRTUAL4R(Error, _import_node, Ref<FBXState>, Ref<FBXNode>, Dictionary, Node *);
 	GDVIRTUAL2R(Error, _import_post, Ref<FBXState>, Node *);
+	GDVIRTUAL0R(uint32_t, _get_implemented_hooks);
+	GDVIRTUAL2R(Error, _parse_nodes, Ref<FBXState>, TypedArray<FBXNode>);
+	GDVIRTUAL2R(Dictionary, _generate_scene_nodes, Ref<FBXState>, TypedArray<FBXNode>);
+	GDVIRTUAL3R(Error, _import_nodes, Ref<FBXState>, PackedInt32Array, TypedArray<Node>);
 };
 
 #endif // FBX_DOCUMENT_EXTENSION_H
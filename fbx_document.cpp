@@ -37,13 +37,17 @@
 #include "core/io/config_file.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
-#include "core/io/file_access_memory.h"
 #include "core/io/image.h"
 #include "core/io/json.h"
+#include "core/io/marshalls.h"
 #include "core/io/stream_peer.h"
 #include "core/math/color.h"
 #include "core/math/disjoint_set.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
+#include "core/templates/local_vector.h"
 #include "core/version.h"
 #include "drivers/png/png_driver_common.h"
 #include "scene/3d/bone_attachment_3d.h"
@@ -56,7 +60,6 @@
 #include "scene/resources/material.h"
 #include "scene/resources/portable_compressed_texture.h"
 #include "scene/resources/skin.h"
-#include "scene/resources/surface_tool.h"
 
 #include "modules/modules_enabled.gen.h" // For csg, gridmap.
 
@@ -74,6 +77,7 @@
 #define FBX_IMPORT_USE_NAMED_SKIN_BINDS 16
 #define FBX_IMPORT_DISCARD_MESHES_AND_MATERIALS 32
 
+#include "thirdparty/misc/mikktspace.h"
 #include "thirdparty/ufbx/ufbx.h"
 
 #include <stdio.h>
@@ -81,6 +85,13 @@
 #include <cstdint>
 #include <limits>
 
+#ifdef UNIX_ENABLED
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 static size_t _file_access_read_fn(void *user, void *data, size_t size) {
 	FileAccess *file = static_cast<FileAccess *>(user);
 	return (size_t)file->get_buffer((uint8_t *)data, (uint64_t)size);
@@ -92,6 +103,217 @@ static bool _file_access_skip_fn(void *user, size_t size) {
 	return true;
 }
 
+// Read-only memory mapping of a file on the native filesystem, so ufbx can parse it from
+// one contiguous block without copying it through `FileAccess`.
+struct FBXMappedFile {
+	const uint8_t *data = nullptr;
+	size_t size = 0;
+
+	bool open(const String &p_path) {
+#ifdef UNIX_ENABLED
+		// Files inside packs or other virtual filesystems have no native path to map.
+		if (!p_path.begins_with("/")) {
+			return false;
+		}
+		int fd = ::open(p_path.utf8().get_data(), O_RDONLY);
+		if (fd < 0) {
+			return false;
+		}
+		struct stat st;
+		if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+			::close(fd);
+			return false;
+		}
+		void *ptr = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		// The mapping stays valid after the descriptor is closed.
+		::close(fd);
+		if (ptr == MAP_FAILED) {
+			return false;
+		}
+		madvise(ptr, size_t(st.st_size), MADV_SEQUENTIAL);
+		data = static_cast<const uint8_t *>(ptr);
+		size = size_t(st.st_size);
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	~FBXMappedFile() {
+#ifdef UNIX_ENABLED
+		if (data) {
+			munmap(const_cast<uint8_t *>(data), size);
+		}
+#endif
+	}
+};
+
+// Bump allocator for the temporary allocations ufbx makes while loading. Nearly all of them
+// are released together at the end of the load, so individual frees only rewind the most
+// recent allocation and everything else is released at once when the arena is destroyed.
+// Huge allocations bypass the arena, the size passed back to `free()` tells them apart.
+class FBXArenaAllocator {
+	struct Block {
+		Block *next = nullptr;
+		size_t size = 0;
+		size_t used = 0;
+	};
+
+	static constexpr size_t ALIGNMENT = 16;
+	static constexpr size_t HEADER_SIZE = (sizeof(Block) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	static constexpr size_t MIN_BLOCK_SIZE = 1 << 20;
+	static constexpr size_t MAX_BLOCK_SIZE = 64 << 20;
+	static constexpr size_t HUGE_SIZE = 4 << 20;
+
+	Block *blocks = nullptr;
+	size_t next_block_size = MIN_BLOCK_SIZE;
+	uint8_t *last = nullptr;
+
+	static size_t _align(size_t p_size) {
+		return (p_size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	}
+
+	static uint8_t *_block_data(Block *p_block) {
+		return reinterpret_cast<uint8_t *>(p_block) + HEADER_SIZE;
+	}
+
+	void *_alloc(size_t p_size) {
+		if (p_size >= HUGE_SIZE) {
+			return Memory::alloc_static(p_size);
+		}
+		const size_t size = _align(MAX(p_size, size_t(1)));
+		if (!blocks || blocks->used + size > blocks->size) {
+			const size_t block_size = MAX(next_block_size, size);
+			Block *block = static_cast<Block *>(Memory::alloc_static(HEADER_SIZE + block_size));
+			if (!block) {
+				return nullptr;
+			}
+			block->next = blocks;
+			block->size = block_size;
+			block->used = 0;
+			blocks = block;
+			next_block_size = MIN(next_block_size * 2, MAX_BLOCK_SIZE);
+		}
+		last = _block_data(blocks) + blocks->used;
+		blocks->used += size;
+		return last;
+	}
+
+	void _free(void *p_ptr, size_t p_size) {
+		if (p_size >= HUGE_SIZE) {
+			Memory::free_static(p_ptr);
+		} else if (p_ptr == last) {
+			blocks->used = size_t(last - _block_data(blocks));
+			last = nullptr;
+		}
+	}
+
+	void *_realloc(void *p_ptr, size_t p_old_size, size_t p_new_size) {
+		if (p_old_size >= HUGE_SIZE && p_new_size >= HUGE_SIZE) {
+			return Memory::realloc_static(p_ptr, p_new_size);
+		}
+		if (p_ptr == last && p_new_size < HUGE_SIZE) {
+			// Grow or shrink the most recent allocation in place.
+			const size_t offset = size_t(last - _block_data(blocks));
+			const size_t size = _align(MAX(p_new_size, size_t(1)));
+			if (offset + size <= blocks->size) {
+				blocks->used = offset + size;
+				return p_ptr;
+			}
+		}
+		void *ptr = _alloc(p_new_size);
+		if (ptr) {
+			memcpy(ptr, p_ptr, MIN(p_old_size, p_new_size));
+			_free(p_ptr, p_old_size);
+		}
+		return ptr;
+	}
+
+public:
+	static void *alloc_fn(void *p_user, size_t p_size) {
+		return static_cast<FBXArenaAllocator *>(p_user)->_alloc(p_size);
+	}
+
+	static void *realloc_fn(void *p_user, void *p_old_ptr, size_t p_old_size, size_t p_new_size) {
+		return static_cast<FBXArenaAllocator *>(p_user)->_realloc(p_old_ptr, p_old_size, p_new_size);
+	}
+
+	static void free_fn(void *p_user, void *p_ptr, size_t p_size) {
+		static_cast<FBXArenaAllocator *>(p_user)->_free(p_ptr, p_size);
+	}
+
+	~FBXArenaAllocator() {
+		while (blocks) {
+			Block *next = blocks->next;
+			Memory::free_static(blocks);
+			blocks = next;
+		}
+	}
+};
+
+// The scene keeps its allocator, so result allocations go through the Godot allocator
+// without any user state that would have to outlive the scene.
+static void *_result_alloc_fn(void *p_user, size_t p_size) {
+	return Memory::alloc_static(p_size);
+}
+
+static void *_result_realloc_fn(void *p_user, void *p_old_ptr, size_t p_old_size, size_t p_new_size) {
+	return Memory::realloc_static(p_old_ptr, p_new_size);
+}
+
+static void _result_free_fn(void *p_user, void *p_ptr, size_t p_size) {
+	Memory::free_static(p_ptr);
+}
+
+static void _begin_profile_entry(FBXState::ProfileEntry &r_entry) {
+	r_entry.begin_usec = OS::get_singleton()->get_ticks_usec();
+	r_entry.thread_id = Thread::get_caller_id();
+	r_entry.begin_memory_usage = OS::get_singleton()->get_static_memory_usage();
+	r_entry.begin_memory_peak = OS::get_singleton()->get_static_memory_peak_usage();
+}
+
+static void _end_profile_entry(FBXState::ProfileEntry &r_entry) {
+	r_entry.duration_usec = OS::get_singleton()->get_ticks_usec() - r_entry.begin_usec;
+	r_entry.memory_usage = OS::get_singleton()->get_static_memory_usage();
+	r_entry.memory_peak = OS::get_singleton()->get_static_memory_peak_usage();
+	// The peak is the process high-water mark. When the stage didn't raise it, its own peak is
+	// unknown and the memory it still holds at the end is used instead.
+	const uint64_t stage_peak = r_entry.memory_peak > r_entry.begin_memory_peak ? r_entry.memory_peak : r_entry.memory_usage;
+	r_entry.memory_growth = stage_peak > r_entry.begin_memory_usage ? stage_peak - r_entry.begin_memory_usage : 0;
+}
+
+// Adds an entry covering its own lifetime to the state's profile, if profiling is enabled.
+class FBXProfileScope {
+	FBXState *state = nullptr;
+	FBXState::ProfileEntry entry;
+
+public:
+	void set_count(int64_t p_count) {
+		entry.count = p_count;
+	}
+
+	void set_allocation_count(int64_t p_allocation_count) {
+		entry.allocation_count = p_allocation_count;
+	}
+
+	FBXProfileScope(FBXState *p_state, const String &p_name, const String &p_category = "stage", bool p_detail = false) {
+		if (!p_state->get_profiling_enabled() || (p_detail && !p_state->get_detailed_profiling())) {
+			return;
+		}
+		state = p_state;
+		entry.name = p_name;
+		entry.category = p_category;
+		_begin_profile_entry(entry);
+	}
+
+	~FBXProfileScope() {
+		if (state) {
+			_end_profile_entry(entry);
+			state->add_profile_entry(entry);
+		}
+	}
+};
+
 static String _as_string(const ufbx_string &p_string) {
 	return String::utf8(p_string.data, (int)p_string.length);
 }
@@ -175,6 +397,151 @@ static Ref<Image> _get_decompressed_image(Ref<Texture2D> texture) {
 	return image;
 }
 
+// Classifies RGBA8 pixels the same way `Image::detect_alpha()` does. The loop has no early exit
+// so the compiler can vectorize it.
+static Image::AlphaMode _detect_rgba8_alpha(const uint8_t *p_data, int64_t p_pixel_count) {
+	uint8_t bit = 0;
+	uint8_t blend = 0;
+	for (int64_t i = 0; i < p_pixel_count; i++) {
+		const uint8_t alpha = p_data[i * 4 + 3];
+		bit |= uint8_t(alpha < 2);
+		blend |= uint8_t(alpha >= 2 && alpha < 254);
+	}
+	if (blend) {
+		return Image::ALPHA_BLEND;
+	}
+	return bit ? Image::ALPHA_BIT : Image::ALPHA_NONE;
+}
+
+// Multiplies the alpha of an RGBA8 image by an R8 or L8 image of the same size, working on the
+// byte buffers directly, and returns the alpha mode of the result.
+static Image::AlphaMode _multiply_image_alpha(Ref<Image> p_image, const Ref<Image> &p_alpha) {
+	const int64_t pixel_count = int64_t(p_image->get_width()) * p_image->get_height();
+	ERR_FAIL_COND_V(p_image->get_format() != Image::FORMAT_RGBA8, Image::ALPHA_NONE);
+	ERR_FAIL_COND_V(p_alpha->get_format() != Image::FORMAT_R8 && p_alpha->get_format() != Image::FORMAT_L8, Image::ALPHA_NONE);
+	ERR_FAIL_COND_V(p_alpha->get_width() != p_image->get_width() || p_alpha->get_height() != p_image->get_height(), Image::ALPHA_NONE);
+
+	Vector<uint8_t> data = p_image->get_data();
+	const Vector<uint8_t> alpha_data = p_alpha->get_data();
+	uint8_t *w = data.ptrw();
+	const uint8_t *r = alpha_data.ptr();
+	for (int64_t i = 0; i < pixel_count; i++) {
+		w[i * 4 + 3] = uint8_t((uint32_t(w[i * 4 + 3]) * uint32_t(r[i])) / 255);
+	}
+	const Image::AlphaMode alpha_mode = _detect_rgba8_alpha(w, pixel_count);
+	p_image->set_data(p_image->get_width(), p_image->get_height(), p_image->has_mipmaps(), Image::FORMAT_RGBA8, data);
+	return alpha_mode;
+}
+
+static bool _image_format_has_alpha(Image::Format p_format) {
+	switch (p_format) {
+		case Image::FORMAT_L8:
+		case Image::FORMAT_R8:
+		case Image::FORMAT_RG8:
+		case Image::FORMAT_RGB8:
+		case Image::FORMAT_RGB565:
+		case Image::FORMAT_RF:
+		case Image::FORMAT_RGF:
+		case Image::FORMAT_RGBF:
+		case Image::FORMAT_RH:
+		case Image::FORMAT_RGH:
+		case Image::FORMAT_RGBH:
+		case Image::FORMAT_RGBE9995:
+		case Image::FORMAT_RGTC_R:
+		case Image::FORMAT_RGTC_RG:
+		case Image::FORMAT_BPTC_RGBF:
+		case Image::FORMAT_BPTC_RGBFU:
+		case Image::FORMAT_ETC:
+		case Image::FORMAT_ETC2_R11:
+		case Image::FORMAT_ETC2_R11S:
+		case Image::FORMAT_ETC2_RG11:
+		case Image::FORMAT_ETC2_RG11S:
+		case Image::FORMAT_ETC2_RGB8:
+			return false;
+		default:
+			return true;
+	}
+}
+
+// Picks the alpha mode of a texture, only decompressing it when its format can actually contain alpha.
+static Image::AlphaMode _detect_texture_alpha(Ref<Texture2D> p_texture) {
+	if (p_texture.is_null()) {
+		return Image::ALPHA_NONE;
+	}
+	Ref<Image> image = p_texture->get_image();
+	if (image.is_null() || !_image_format_has_alpha(image->get_format())) {
+		return Image::ALPHA_NONE;
+	}
+	if (image->is_compressed()) {
+		image = image->duplicate();
+		image->decompress();
+	}
+	return image->detect_alpha();
+}
+
+// Packs the `K` largest influences of every FBX vertex of a skin, normalized to sum to one.
+// ufbx sorts the weights of every vertex by decreasing weight while loading, so these are the
+// first `K`. Normalization runs as a separate fixed-width pass.
+template <int K>
+static void _pack_skin_weights(const ufbx_skin_deformer *p_skin, bool p_quantize, LocalVector<int32_t> &r_bones, LocalVector<float> &r_weights) {
+	const size_t vertex_count = p_skin->vertices.count;
+	r_bones.resize(vertex_count * K);
+	r_weights.resize(vertex_count * K);
+	int32_t *bones = r_bones.ptr();
+	float *weights = r_weights.ptr();
+
+	for (size_t vertex_i = 0; vertex_i < vertex_count; vertex_i++) {
+		const ufbx_skin_vertex &skin_vertex = p_skin->vertices.data[vertex_i];
+		int32_t *vertex_bones = bones + vertex_i * K;
+		float *vertex_weights = weights + vertex_i * K;
+		const int count = MIN(int(skin_vertex.num_weights), K);
+		for (int i = 0; i < count; i++) {
+			const ufbx_skin_weight &skin_weight = p_skin->weights.data[skin_vertex.weight_begin + i];
+			vertex_bones[i] = int32_t(skin_weight.cluster_index);
+			vertex_weights[i] = float(skin_weight.weight);
+		}
+		// Unused influences are bone 0 with no weight, like the ones Godot adds itself.
+		for (int i = count; i < K; i++) {
+			vertex_bones[i] = 0;
+			vertex_weights[i] = 0.0f;
+		}
+	}
+
+	for (size_t vertex_i = 0; vertex_i < vertex_count; vertex_i++) {
+		float *vertex_weights = weights + vertex_i * K;
+		float total_weight = 0.0f;
+		for (int i = 0; i < K; i++) {
+			total_weight += vertex_weights[i];
+		}
+		const float scale = total_weight > 0.0f ? 1.0f / total_weight : 1.0f;
+		for (int i = 0; i < K; i++) {
+			vertex_weights[i] *= scale;
+		}
+	}
+
+	if (!p_quantize) {
+		return;
+	}
+
+	// Snap to the 16-bit steps the weights are stored with and give the rounding error to the
+	// largest influence, so every vertex sums to exactly one after compression.
+	for (size_t vertex_i = 0; vertex_i < vertex_count; vertex_i++) {
+		float *vertex_weights = weights + vertex_i * K;
+		int32_t quantized[K];
+		int32_t total = 0;
+		for (int i = 0; i < K; i++) {
+			quantized[i] = int32_t(Math::round(vertex_weights[i] * 65535.0f));
+			total += quantized[i];
+		}
+		if (total > 0) {
+			quantized[0] += 65535 - total;
+		}
+		for (int i = 0; i < K; i++) {
+			vertex_weights[i] = float(quantized[i]) / 65535.0f;
+		}
+	}
+}
+
 static Vector<Vector2> _decode_vertex_attrib_vec2(const ufbx_vertex_vec2 &p_attrib, const Vector<uint32_t> &p_indices) {
 	Vector<Vector2> ret;
 
@@ -223,12 +590,182 @@ static Vector<Color> _decode_vertex_attrib_color(const ufbx_vertex_vec4 &p_attri
 	return ret;
 }
 
-static Vector3 _encode_vertex_index(uint32_t p_index) {
-	return Vector3(real_t(p_index & 0xffff), real_t(p_index >> 16), 0.0f);
+template <class T>
+static void _add_vertex_stream(LocalVector<ufbx_vertex_stream> &r_streams, Vector<T> &p_data, int p_components = 1) {
+	ufbx_vertex_stream stream = {};
+	stream.data = p_data.ptrw();
+	stream.vertex_count = size_t(p_data.size() / p_components);
+	stream.vertex_size = sizeof(T) * size_t(p_components);
+	r_streams.push_back(stream);
+}
+
+// Largest error of a texture coordinate stored as 16 bits normalized to its range, the way
+// the compressed vertex format stores it.
+static real_t _get_compressed_uv_error(const Vector<Vector2> &p_uvs) {
+	real_t max_abs = 1.0;
+	for (const Vector2 &uv : p_uvs) {
+		max_abs = MAX(max_abs, MAX(Math::abs(uv.x), Math::abs(uv.y)));
+	}
+	return 2.0 * max_abs / 65535.0;
+}
+
+// Requests the compressed vertex format for the surface when it stays within `p_max_error`:
+// positions and texture coordinates become 16 bits normalized to their ranges, and normals
+// and tangents are octahedral packed. Custom channels are converted to half floats on their own.
+static void _compress_surface_attributes(real_t p_max_error, Array &r_array, const Array &p_morphs, uint32_t &r_flags) {
+	// The position range covers the blend shapes too, they share the base surface's bounds.
+	const Vector<Vector3> vertices = r_array[Mesh::ARRAY_VERTEX];
+	AABB aabb;
+	if (!vertices.is_empty()) {
+		aabb.position = vertices[0];
+	}
+	for (const Vector3 &vertex : vertices) {
+		aabb.expand_to(vertex);
+	}
+	for (int morph_i = 0; morph_i < p_morphs.size(); morph_i++) {
+		const Array morph = p_morphs[morph_i];
+		const Vector<Vector3> morph_vertices = morph[Mesh::ARRAY_VERTEX];
+		for (const Vector3 &vertex : morph_vertices) {
+			aabb.expand_to(vertex);
+		}
+	}
+	bool compress = aabb.get_longest_axis_size() / 65535.0 <= p_max_error;
+	if (r_array[Mesh::ARRAY_TEX_UV].get_type() == Variant::PACKED_VECTOR2_ARRAY) {
+		compress = compress && _get_compressed_uv_error(r_array[Mesh::ARRAY_TEX_UV]) <= p_max_error;
+	}
+	if (r_array[Mesh::ARRAY_TEX_UV2].get_type() == Variant::PACKED_VECTOR2_ARRAY) {
+		compress = compress && _get_compressed_uv_error(r_array[Mesh::ARRAY_TEX_UV2]) <= p_max_error;
+	}
+	if (compress) {
+		r_flags |= Mesh::ARRAY_FLAG_COMPRESS_ATTRIBUTES;
+	}
+
+	for (int custom_i = 0; custom_i < Mesh::ARRAY_CUSTOM_COUNT; custom_i++) {
+		const int custom_shift = Mesh::ARRAY_FORMAT_CUSTOM0_SHIFT + custom_i * Mesh::ARRAY_FORMAT_CUSTOM_BITS;
+		const uint32_t custom_format = (r_flags >> custom_shift) & Mesh::ARRAY_FORMAT_CUSTOM_MASK;
+		if (custom_format != Mesh::ARRAY_CUSTOM_RG_FLOAT && custom_format != Mesh::ARRAY_CUSTOM_RGBA_FLOAT) {
+			continue;
+		}
+		const Vector<float> custom = r_array[Mesh::ARRAY_CUSTOM0 + custom_i];
+		// Rounding to a half float is off by at most 2^-11 of the value.
+		float max_abs = 0.0f;
+		for (const float value : custom) {
+			max_abs = MAX(max_abs, Math::abs(value));
+		}
+		if (max_abs > 65504.0f || max_abs / 2048.0f > p_max_error) {
+			continue;
+		}
+		Vector<uint8_t> half_custom;
+		half_custom.resize(custom.size() * sizeof(uint16_t));
+		uint16_t *w = reinterpret_cast<uint16_t *>(half_custom.ptrw());
+		for (int i = 0; i < custom.size(); i++) {
+			w[i] = Math::make_half_float(custom[i]);
+		}
+		r_array[Mesh::ARRAY_CUSTOM0 + custom_i] = half_custom;
+		r_flags &= ~(uint32_t(Mesh::ARRAY_FORMAT_CUSTOM_MASK) << custom_shift);
+		r_flags |= uint32_t(custom_format == Mesh::ARRAY_CUSTOM_RG_FLOAT ? Mesh::ARRAY_CUSTOM_RG_HALF : Mesh::ARRAY_CUSTOM_RGBA_HALF) << custom_shift;
+	}
+}
+
+struct FBXTangentContext {
+	const Vector3 *vertices = nullptr;
+	const Vector3 *normals = nullptr;
+	const Vector2 *uvs = nullptr;
+	const int *indices = nullptr;
+	float *tangents = nullptr;
+	// Optional subset of triangles to process, all `num_faces` triangles are used when null.
+	const int *faces = nullptr;
+	int num_faces = 0;
+	// Optional write mask, only vertices whose stamp equals `write_stamp` receive tangents.
+	const uint32_t *write_stamps = nullptr;
+	uint32_t write_stamp = 0;
+};
+
+static int _mikk_get_vertex_index(const FBXTangentContext *p_context, const int p_face, const int p_vertex) {
+	const int face = p_context->faces ? p_context->faces[p_face] : p_face;
+	return p_context->indices[face * 3 + p_vertex];
+}
+
+static int _mikk_get_num_faces(const SMikkTSpaceContext *p_context) {
+	const FBXTangentContext *context = static_cast<const FBXTangentContext *>(p_context->m_pUserData);
+	return context->num_faces;
+}
+
+static int _mikk_get_num_vertices_of_face(const SMikkTSpaceContext *p_context, const int p_face) {
+	return 3;
+}
+
+static void _mikk_get_position(const SMikkTSpaceContext *p_context, float r_position[], const int p_face, const int p_vertex) {
+	const FBXTangentContext *context = static_cast<const FBXTangentContext *>(p_context->m_pUserData);
+	const Vector3 &v = context->vertices[_mikk_get_vertex_index(context, p_face, p_vertex)];
+	r_position[0] = v.x;
+	r_position[1] = v.y;
+	r_position[2] = v.z;
+}
+
+static void _mikk_get_normal(const SMikkTSpaceContext *p_context, float r_normal[], const int p_face, const int p_vertex) {
+	const FBXTangentContext *context = static_cast<const FBXTangentContext *>(p_context->m_pUserData);
+	const Vector3 &v = context->normals[_mikk_get_vertex_index(context, p_face, p_vertex)];
+	r_normal[0] = v.x;
+	r_normal[1] = v.y;
+	r_normal[2] = v.z;
+}
+
+static void _mikk_get_tex_coord(const SMikkTSpaceContext *p_context, float r_tex_coord[], const int p_face, const int p_vertex) {
+	const FBXTangentContext *context = static_cast<const FBXTangentContext *>(p_context->m_pUserData);
+	const Vector2 &v = context->uvs[_mikk_get_vertex_index(context, p_face, p_vertex)];
+	r_tex_coord[0] = v.x;
+	r_tex_coord[1] = v.y;
+}
+
+static void _mikk_set_tspace_basic(const SMikkTSpaceContext *p_context, const float p_tangent[], const float p_sign, const int p_face, const int p_vertex) {
+	const FBXTangentContext *context = static_cast<const FBXTangentContext *>(p_context->m_pUserData);
+	const int index = _mikk_get_vertex_index(context, p_face, p_vertex);
+	if (context->write_stamps && context->write_stamps[index] != context->write_stamp) {
+		return;
+	}
+	float *tangent = context->tangents + index * 4;
+	tangent[0] = p_tangent[0];
+	tangent[1] = p_tangent[1];
+	tangent[2] = p_tangent[2];
+	// Godot's binormal points the opposite way of the mikktspace bitangent (see `SurfaceTool`).
+	tangent[3] = p_sign < 0.0f ? 1.0f : -1.0f;
+}
+
+static void _generate_tangents(FBXTangentContext &p_context) {
+	SMikkTSpaceInterface mikktspace_interface = {};
+	mikktspace_interface.m_getNumFaces = _mikk_get_num_faces;
+	mikktspace_interface.m_getNumVerticesOfFace = _mikk_get_num_vertices_of_face;
+	mikktspace_interface.m_getPosition = _mikk_get_position;
+	mikktspace_interface.m_getNormal = _mikk_get_normal;
+	mikktspace_interface.m_getTexCoord = _mikk_get_tex_coord;
+	mikktspace_interface.m_setTSpaceBasic = _mikk_set_tspace_basic;
+
+	SMikkTSpaceContext mikktspace_context = {};
+	mikktspace_context.m_pInterface = &mikktspace_interface;
+	mikktspace_context.m_pUserData = &p_context;
+	genTangSpaceDefault(&mikktspace_context);
 }
 
-static uint32_t _decode_vertex_index(const Vector3 &p_vertex) {
-	return uint32_t(p_vertex.x) | uint32_t(p_vertex.y) << 16;
+// Generates mikktspace tangents for an indexed triangle list, `r_tangents` must hold 4 floats per vertex.
+static void _generate_tangents(const Vector<Vector3> &p_vertices, const Vector<Vector3> &p_normals, const Vector<Vector2> &p_uvs, const Vector<int> &p_indices, Vector<float> &r_tangents) {
+	ERR_FAIL_COND(r_tangents.size() != p_vertices.size() * 4);
+	float *w_tangents = r_tangents.ptrw();
+	for (int i = 0; i < p_vertices.size(); i++) {
+		w_tangents[i * 4 + 0] = 0.0f;
+		w_tangents[i * 4 + 1] = 0.0f;
+		w_tangents[i * 4 + 2] = 0.0f;
+		w_tangents[i * 4 + 3] = 1.0f;
+	}
+
+	FBXTangentContext context;
+	context.vertices = p_vertices.ptr();
+	context.normals = p_normals.ptr();
+	context.uvs = p_uvs.ptr();
+	context.indices = p_indices.ptr();
+	context.tangents = w_tangents;
+	context.num_faces = p_indices.size() / 3;
+	_generate_tangents(context);
 }
 
 // static Vector3 _arr_to_vec3(const Array &p_array) {
@@ -253,28 +790,39 @@ static uint32_t _decode_vertex_index(const Vector3 &p_vertex) {
 // 	return xform;
 // }
 
-String FBXDocument::_gen_unique_name(Ref<FBXState> p_state, const String &p_name) {
-	const String s_name = p_name.validate_node_name();
+// Reserves the first free name among `p_base`, then `p_base` + `p_separator` + 2, 3 and so on.
+// `r_counters` keeps the last suffix given out for each base. Names are never removed from
+// `r_names`, so every smaller suffix is still taken and probing resumes from there.
+static String _alloc_unique_name(HashSet<String> &r_names, HashMap<String, int> &r_counters, const String &p_base, const String &p_separator) {
+	int *counter = r_counters.getptr(p_base);
+	if (!counter) {
+		counter = &r_counters.insert(p_base, 1)->value;
+	}
 
 	String u_name;
-	int index = 1;
+	int index = *counter;
 	while (true) {
-		u_name = s_name;
+		u_name = p_base;
 
 		if (index > 1) {
-			u_name += itos(index);
+			u_name += p_separator + itos(index);
 		}
-		if (!p_state->unique_names.has(u_name)) {
+		if (!r_names.has(u_name)) {
 			break;
 		}
 		index++;
 	}
 
-	p_state->unique_names.insert(u_name);
+	*counter = index;
+	r_names.insert(u_name);
 
 	return u_name;
 }
 
+String FBXDocument::_gen_unique_name(Ref<FBXState> p_state, const String &p_name) {
+	return _alloc_unique_name(p_state->unique_names, p_state->unique_name_counters, p_name.validate_node_name(), String());
+}
+
 String FBXDocument::_sanitize_animation_name(const String &p_name) {
 	// Animations disallow the normal node invalid characters as well as  "," and "["
 	// (See animation/animation_player.cpp::add_animation)
@@ -287,25 +835,7 @@ String FBXDocument::_sanitize_animation_name(const String &p_name) {
 }
 
 String FBXDocument::_gen_unique_animation_name(Ref<FBXState> p_state, const String &p_name) {
-	const String s_name = _sanitize_animation_name(p_name);
-
-	String u_name;
-	int index = 1;
-	while (true) {
-		u_name = s_name;
-
-		if (index > 1) {
-			u_name += itos(index);
-		}
-		if (!p_state->unique_animation_names.has(u_name)) {
-			break;
-		}
-		index++;
-	}
-
-	p_state->unique_animation_names.insert(u_name);
-
-	return u_name;
+	return _alloc_unique_name(p_state->unique_animation_names, p_state->unique_animation_name_counters, _sanitize_animation_name(p_name), String());
 }
 
 String FBXDocument::_sanitize_bone_name(const String &p_name) {
@@ -320,23 +850,8 @@ String FBXDocument::_gen_unique_bone_name(Ref<FBXState> p_state, const FBXSkelet
 	if (s_name.is_empty()) {
 		s_name = "bone";
 	}
-	String u_name;
-	int index = 1;
-	while (true) {
-		u_name = s_name;
-
-		if (index > 1) {
-			u_name += "_" + itos(index);
-		}
-		if (!p_state->skeletons[p_skel_i]->unique_names.has(u_name)) {
-			break;
-		}
-		index++;
-	}
-
-	p_state->skeletons.write[p_skel_i]->unique_names.insert(u_name);
-
-	return u_name;
+	Ref<FBXSkeleton> skeleton = p_state->skeletons[p_skel_i];
+	return _alloc_unique_name(skeleton->unique_names, skeleton->unique_name_counters, s_name, "_");
 }
 
 Error FBXDocument::_parse_scenes(Ref<FBXState> p_state) {
@@ -357,55 +872,118 @@ Error FBXDocument::_parse_scenes(Ref<FBXState> p_state) {
 
 Error FBXDocument::_parse_nodes(Ref<FBXState> p_state) {
 	const ufbx_scene *fbx_scene = p_state->scene.get();
+	FBXNodeTable &table = p_state->node_table;
+	table.clear();
+	p_state->nodes.clear();
 
 	for (int node_i = 0; node_i < static_cast<int>(fbx_scene->nodes.count); node_i++) {
 		const ufbx_node *fbx_node = fbx_scene->nodes[node_i];
 
-		Ref<FBXNode> node;
-		node.instantiate();
+		const FBXNodeIndex node = table.push_node();
 
-		node->height = int(fbx_node->node_depth);
+		table.heights[node] = int(fbx_node->node_depth);
 
 		if (fbx_node->name.length > 0) {
-			node->set_name(_as_string(fbx_node->name));
+			table.names[node] = _as_string(fbx_node->name);
 		} else if (fbx_node->is_root) {
-			node->set_name("Root");
+			table.names[node] = "Root";
 		}
 		if (fbx_node->mesh) {
-			node->mesh = fbx_node->mesh->typed_id;
+			table.meshes[node] = fbx_node->mesh->typed_id;
 		}
 
 		{
-			node->position = _as_vec3(fbx_node->local_transform.translation);
-			node->rotation = _as_quaternion(fbx_node->local_transform.rotation);
-			node->scale = _as_vec3(fbx_node->local_transform.scale);
+			table.positions[node] = _as_vec3(fbx_node->local_transform.translation);
+			table.rotations[node] = _as_quaternion(fbx_node->local_transform.rotation);
+			table.scales[node] = _as_vec3(fbx_node->local_transform.scale);
 
-			node->xform.basis.set_quaternion_scale(node->rotation, node->scale);
-			node->xform.origin = node->position;
+			table.xforms[node].basis.set_quaternion_scale(table.rotations[node], table.scales[node]);
+			table.xforms[node].origin = table.positions[node];
 		}
 
 		for (const ufbx_node *child : fbx_node->children) {
-			node->children.push_back(child->typed_id);
+			table.add_child(child->typed_id);
 		}
-
-		p_state->nodes.push_back(node);
 	}
 
 	// build the hierarchy
-	for (FBXNodeIndex node_i = 0; node_i < p_state->nodes.size(); node_i++) {
-		for (int j = 0; j < p_state->nodes[node_i]->children.size(); j++) {
-			FBXNodeIndex child_i = p_state->nodes[node_i]->children[j];
-
-			ERR_FAIL_INDEX_V(child_i, p_state->nodes.size(), ERR_FILE_CORRUPT);
-			ERR_CONTINUE(p_state->nodes[child_i]->parent != -1); //node already has a parent, wtf.
+	for (FBXNodeIndex node_i = 0; node_i < table.size(); node_i++) {
+		for (const FBXNodeIndex child_i : table.get_children(node_i)) {
+			ERR_FAIL_INDEX_V(child_i, table.size(), ERR_FILE_CORRUPT);
+			ERR_CONTINUE(table.parents[child_i] != -1); //node already has a parent, wtf.
 
-			p_state->nodes.write[child_i]->parent = node_i;
+			table.parents[child_i] = node_i;
 		}
 	}
 
 	return OK;
 }
 
+void FBXDocument::_select_nodes(Ref<FBXState> p_state) {
+	p_state->selected_meshes.clear();
+	p_state->selected_materials.clear();
+	if (p_state->node_filter.is_empty()) {
+		return;
+	}
+	const ufbx_scene *fbx_scene = p_state->scene.get();
+
+	// Every node below one of the named nodes is selected.
+	HashSet<String> filter;
+	for (const String &name : p_state->node_filter) {
+		filter.insert(name);
+	}
+	LocalVector<const ufbx_node *> stack;
+	for (const ufbx_node *fbx_node : fbx_scene->nodes) {
+		if (filter.has(_as_string(fbx_node->name))) {
+			stack.push_back(fbx_node);
+		}
+	}
+	if (stack.is_empty()) {
+		WARN_PRINT("FBX: No node matches the node filter, no meshes will be imported.");
+	}
+	LocalVector<bool> selected_nodes;
+	selected_nodes.resize(fbx_scene->nodes.count);
+	for (bool &selected : selected_nodes) {
+		selected = false;
+	}
+	while (!stack.is_empty()) {
+		const ufbx_node *fbx_node = stack[stack.size() - 1];
+		stack.remove_at(stack.size() - 1);
+		if (selected_nodes[fbx_node->typed_id]) {
+			continue;
+		}
+		selected_nodes[fbx_node->typed_id] = true;
+		for (const ufbx_node *child : fbx_node->children) {
+			stack.push_back(child);
+		}
+	}
+
+	// The nodes outside of the selection are kept, without their meshes.
+	p_state->selected_meshes.resize(fbx_scene->meshes.count);
+	for (bool &selected : p_state->selected_meshes) {
+		selected = false;
+	}
+	p_state->selected_materials.resize(fbx_scene->materials.count);
+	for (bool &selected : p_state->selected_materials) {
+		selected = false;
+	}
+	for (const ufbx_node *fbx_node : fbx_scene->nodes) {
+		if (!fbx_node->mesh) {
+			continue;
+		}
+		if (!selected_nodes[fbx_node->typed_id]) {
+			p_state->node_table.meshes[fbx_node->typed_id] = -1;
+			continue;
+		}
+		p_state->selected_meshes[fbx_node->mesh->typed_id] = true;
+		for (const ufbx_material *fbx_material : fbx_node->mesh->materials) {
+			if (fbx_material) {
+				p_state->selected_materials[fbx_material->typed_id] = true;
+			}
+		}
+	}
+}
+
 // static Vector<uint8_t> _parse_base64_uri(const String &p_uri) {
 // 	int start = p_uri.find(",");
 // 	ERR_FAIL_COND_V(start == -1, Vector<uint8_t>());
@@ -425,17 +1003,561 @@ Error FBXDocument::_parse_nodes(Ref<FBXState> p_state) {
 // 	return buf;
 // }
 
+Error FBXDocument::_parse_mesh_surfaces(const FBXState *p_state, const ufbx_mesh *p_mesh, ParsedMesh &r_mesh) {
+	static const Mesh::PrimitiveType primitive_types[] = {
+		Mesh::PRIMITIVE_TRIANGLES,
+		Mesh::PRIMITIVE_POINTS,
+		Mesh::PRIMITIVE_LINES,
+	};
+
+	bool use_blend_shapes = false;
+	if (p_mesh->blend_deformers.count > 0) {
+		use_blend_shapes = true;
+	}
+
+	// Find the first imported skin deformer
+	const ufbx_skin_deformer *fbx_skin = nullptr;
+	for (const ufbx_skin_deformer *fbx_skin_deformer : p_mesh->skin_deformers) {
+		FBXSkinIndex skin_i = p_state->skin_indices[fbx_skin_deformer->typed_id];
+		if (skin_i >= 0) {
+			fbx_skin = fbx_skin_deformer;
+			// The mesh instances are tagged to use the skin once all meshes are parsed.
+			r_mesh.skin = skin_i;
+			break;
+		}
+	}
+
+	// Skin weights only depend on the FBX vertex, so they are packed once for the whole mesh
+	// and copied to every surface vertex after welding.
+	int32_t num_skin_weights = 0;
+	LocalVector<int32_t> packed_bones;
+	LocalVector<float> packed_weights;
+	if (fbx_skin) {
+		if (fbx_skin->max_weights_per_vertex > 4) {
+			num_skin_weights = 8;
+			_pack_skin_weights<8>(fbx_skin, p_state->quantize_skin_weights, packed_bones, packed_weights);
+		} else {
+			num_skin_weights = 4;
+			_pack_skin_weights<4>(fbx_skin, p_state->quantize_skin_weights, packed_bones, packed_weights);
+		}
+	}
+
+	for (const ufbx_mesh_part &fbx_mesh_part : p_mesh->material_parts) {
+		for (Mesh::PrimitiveType primitive : primitive_types) {
+			uint32_t num_indices = 0;
+			switch (primitive) {
+				case Mesh::PRIMITIVE_POINTS:
+					num_indices = fbx_mesh_part.num_point_faces * 1;
+					break;
+				case Mesh::PRIMITIVE_LINES:
+					num_indices = fbx_mesh_part.num_line_faces * 2;
+					break;
+				case Mesh::PRIMITIVE_TRIANGLES:
+					num_indices = fbx_mesh_part.num_triangles * 3;
+					break;
+				case Mesh::PRIMITIVE_TRIANGLE_STRIP:
+					// FIXME 2021-09-15 fire
+					break;
+				case Mesh::PRIMITIVE_LINE_STRIP:
+					// FIXME 2021-09-15 fire
+					break;
+				default:
+					// FIXME 2021-09-15 fire
+					break;
+			}
+			if (num_indices == 0) {
+				continue;
+			}
+
+			Vector<uint32_t> indices;
+			indices.resize(num_indices);
+
+			uint32_t offset = 0;
+			for (uint32_t face_index : fbx_mesh_part.face_indices) {
+				ufbx_face face = p_mesh->faces[face_index];
+				switch (primitive) {
+					case Mesh::PRIMITIVE_POINTS: {
+						if (face.num_indices == 1) {
+							indices.write[offset] = face.index_begin;
+							offset += 1;
+						}
+					} break;
+					case Mesh::PRIMITIVE_LINES:
+						if (face.num_indices == 2) {
+							indices.write[offset] = face.index_begin;
+							indices.write[offset + 1] = face.index_begin + 1;
+							offset += 2;
+						}
+						break;
+					case Mesh::PRIMITIVE_TRIANGLES:
+						if (face.num_indices >= 3) {
+							uint32_t *dst = indices.ptrw() + offset;
+							size_t space = indices.size() - offset;
+							uint32_t num_triangles = ufbx_triangulate_face(dst, space, p_mesh, face);
+							offset += num_triangles * 3;
+
+							// Godot uses clockwise winding order!
+							for (uint32_t i = 0; i < num_triangles; i++) {
+								SWAP(dst[i * 3 + 0], dst[i * 3 + 2]);
+							}
+						}
+						break;
+					case Mesh::PRIMITIVE_TRIANGLE_STRIP:
+						// FIXME 2021-09-15 fire
+						break;
+					case Mesh::PRIMITIVE_LINE_STRIP:
+						// FIXME 2021-09-15 fire
+						break;
+					default:
+						// FIXME 2021-09-15 fire
+						break;
+				}
+			}
+			ERR_CONTINUE((uint64_t)offset != (uint64_t)indices.size());
+
+			int32_t vertex_num = indices.size();
+			bool has_vertex_color = false;
+
+			uint32_t flags = 0;
+
+			// Every attribute is decoded into one contiguous stream with an entry per face corner.
+			// The streams are welded in place by `ufbx_generate_indices()` below.
+			LocalVector<ufbx_vertex_stream> streams;
+
+			// Blend shapes and skin weights are defined per FBX vertex, so corners that come from
+			// different vertices must never be merged even if all their attributes match. The source
+			// vertex index is welded as an extra stream and kept to look those up after welding.
+			Vector<uint32_t> vertex_sources;
+			if (use_blend_shapes || fbx_skin) {
+				vertex_sources.resize(vertex_num);
+				uint32_t *w_vertex_sources = vertex_sources.ptrw();
+				for (int i = 0; i < vertex_num; i++) {
+					w_vertex_sources[i] = p_mesh->vertex_indices[indices[i]];
+				}
+				_add_vertex_stream(streams, vertex_sources);
+			}
+
+			Vector<Vector3> vertices = _decode_vertex_attrib_vec3(p_mesh->vertex_position, indices);
+			_add_vertex_stream(streams, vertices);
+
+			// Normals always exist as they're generated if missing,
+			// see `ufbx_load_opts.generate_missing_normals`.
+			Vector<Vector3> normals = _decode_vertex_attrib_vec3(p_mesh->vertex_normal, indices);
+			_add_vertex_stream(streams, normals);
+
+			Vector<float> tangents;
+			if (p_mesh->vertex_tangent.exists) {
+				tangents = _decode_vertex_attrib_vec3_as_tangent(p_mesh->vertex_tangent, indices);
+
+				// Patch bitangent sign if available
+				if (p_mesh->vertex_bitangent.exists) {
+					for (int i = 0; i < vertex_num; i++) {
+						Vector3 tangent = Vector3(tangents[i * 4], tangents[i * 4 + 1], tangents[i * 4 + 2]);
+						Vector3 bitangent = _as_vec3(p_mesh->vertex_bitangent[indices[i]]);
+						Vector3 generated_bitangent = normals[i].cross(tangent);
+						if (generated_bitangent.dot(bitangent) < 0.0f) {
+							tangents.write[i * 4 + 3] = -1.0f;
+						}
+					}
+				}
+
+				_add_vertex_stream(streams, tangents, 4);
+			}
+
+			PackedVector2Array uv_array;
+			if (p_mesh->vertex_uv.exists) {
+				uv_array = _decode_vertex_attrib_vec2(p_mesh->vertex_uv, indices);
+				_process_uv_set(uv_array);
+				_add_vertex_stream(streams, uv_array);
+			}
+
+			PackedVector2Array uv2_array;
+			if (p_mesh->uv_sets.count >= 2 && p_mesh->uv_sets[1].vertex_uv.exists) {
+				uv2_array = _decode_vertex_attrib_vec2(p_mesh->uv_sets[1].vertex_uv, indices);
+				_process_uv_set(uv2_array);
+				_add_vertex_stream(streams, uv2_array);
+			}
+
+			Vector<float> customs[3];
+			int custom_channels[3] = { 0, 0, 0 };
+			for (int uv_i = 2; uv_i < 8; uv_i += 2) {
+				Vector<float> cur_custom;
+				Vector<Vector2> texcoord_first;
+				Vector<Vector2> texcoord_second;
+
+				int texcoord_i = uv_i;
+				int texcoord_next = texcoord_i + 1;
+				int num_channels = 0;
+				if (texcoord_i < static_cast<int>(p_mesh->uv_sets.count) && p_mesh->uv_sets[texcoord_i].vertex_uv.exists) {
+					texcoord_first = _decode_vertex_attrib_vec2(p_mesh->uv_sets[texcoord_i].vertex_uv, indices);
+					_process_uv_set(texcoord_first);
+					num_channels = 2;
+				}
+				if (texcoord_next < static_cast<int>(p_mesh->uv_sets.count) && p_mesh->uv_sets[texcoord_next].vertex_uv.exists) {
+					texcoord_second = _decode_vertex_attrib_vec2(p_mesh->uv_sets[texcoord_next].vertex_uv, indices);
+					_process_uv_set(texcoord_second);
+					num_channels = 4;
+				}
+				if (!num_channels) {
+					break;
+				}
+				cur_custom.resize(vertex_num * num_channels);
+				for (int32_t uv_first_i = 0; uv_first_i < texcoord_first.size() && uv_first_i < vertex_num; uv_first_i++) {
+					int index = uv_first_i * num_channels;
+					cur_custom.write[index] = texcoord_first[uv_first_i].x;
+					cur_custom.write[index + 1] = texcoord_first[uv_first_i].y;
+				}
+				if (num_channels == 4) {
+					for (int32_t uv_second_i = 0; uv_second_i < texcoord_second.size() && uv_second_i < vertex_num; uv_second_i++) {
+						int index = uv_second_i * num_channels;
+						cur_custom.write[index + 2] = texcoord_second[uv_second_i].x;
+						cur_custom.write[index + 3] = texcoord_second[uv_second_i].y;
+					}
+					_zero_unused_elements(cur_custom, texcoord_second.size(), vertex_num, num_channels);
+				} else if (num_channels == 2) {
+					_zero_unused_elements(cur_custom, texcoord_first.size(), vertex_num, num_channels);
+				}
+				if (!cur_custom.is_empty()) {
+					const int custom_i = (uv_i - 2) / 2; // Map uv2-uv7 to custom0-custom2
+					customs[custom_i] = cur_custom;
+					custom_channels[custom_i] = num_channels;
+					_add_vertex_stream(streams, customs[custom_i], num_channels);
+					int custom_shift = Mesh::ARRAY_FORMAT_CUSTOM0_SHIFT + custom_i * Mesh::ARRAY_FORMAT_CUSTOM_BITS;
+					flags |= (num_channels == 2 ? Mesh::ARRAY_CUSTOM_RG_FLOAT : Mesh::ARRAY_CUSTOM_RGBA_FLOAT) << custom_shift;
+				}
+			}
+
+			Vector<Color> colors;
+			if (p_mesh->vertex_color.exists) {
+				colors = _decode_vertex_attrib_color(p_mesh->vertex_color, indices);
+				_add_vertex_stream(streams, colors);
+				has_vertex_color = true;
+			}
+			if (p_state->release_scene_data) {
+				// Every stream is decoded, don't hold on to the corner indices while welding.
+				indices.clear();
+			}
+
+			// Weld identical corners: this compacts every stream in place and produces the index buffer.
+			Vector<int> index_array;
+			index_array.resize(vertex_num);
+			ufbx_error error;
+			const size_t num_vertices = ufbx_generate_indices(streams.ptr(), streams.size(), (uint32_t *)index_array.ptrw(), index_array.size(), nullptr, &error);
+			if (num_vertices == 0) {
+				char err_buf[512];
+				ufbx_format_error(err_buf, sizeof(err_buf), &error);
+				ERR_FAIL_V_MSG(ERR_PARSE_ERROR, err_buf);
+			}
+			vertex_num = int32_t(num_vertices);
+
+			if (!vertex_sources.is_empty()) {
+				vertex_sources.resize(vertex_num);
+			}
+			vertices.resize(vertex_num);
+			normals.resize(vertex_num);
+			if (!tangents.is_empty()) {
+				tangents.resize(vertex_num * 4);
+			}
+			if (!uv_array.is_empty()) {
+				uv_array.resize(vertex_num);
+			}
+			if (!uv2_array.is_empty()) {
+				uv2_array.resize(vertex_num);
+			}
+			for (int custom_i = 0; custom_i < 3; custom_i++) {
+				if (!customs[custom_i].is_empty()) {
+					customs[custom_i].resize(vertex_num * custom_channels[custom_i]);
+				}
+			}
+			if (!colors.is_empty()) {
+				colors.resize(vertex_num);
+			}
+
+			// Skin weights only depend on the source vertex, so they are gathered after welding.
+			Vector<int32_t> bones;
+			Vector<float> weights;
+			if (fbx_skin) {
+				bones.resize(vertex_num * num_skin_weights);
+				weights.resize(vertex_num * num_skin_weights);
+				int32_t *w_bones = bones.ptrw();
+				float *w_weights = weights.ptrw();
+				const uint32_t *r_vertex_sources = vertex_sources.ptr();
+				const size_t stride = size_t(num_skin_weights);
+				for (int32_t vertex_i = 0; vertex_i < vertex_num; vertex_i++) {
+					const size_t src = size_t(r_vertex_sources[vertex_i]) * stride;
+					memcpy(w_bones + vertex_i * stride, packed_bones.ptr() + src, stride * sizeof(int32_t));
+					memcpy(w_weights + vertex_i * stride, packed_weights.ptr() + src, stride * sizeof(float));
+				}
+
+				if (num_skin_weights == 8) {
+					flags |= Mesh::ARRAY_FLAG_USE_8_BONE_WEIGHTS;
+				}
+			}
+
+			bool generate_tangents = (primitive == Mesh::PRIMITIVE_TRIANGLES && tangents.is_empty() && !uv_array.is_empty() && !normals.is_empty());
+			if (generate_tangents) {
+				//must generate mikktspace tangents.. ergh..
+				tangents.resize(vertex_num * 4);
+				_generate_tangents(vertices, normals, uv_array, index_array, tangents);
+			}
+
+			Array array;
+			array.resize(Mesh::ARRAY_MAX);
+			array[Mesh::ARRAY_VERTEX] = vertices;
+			array[Mesh::ARRAY_NORMAL] = normals;
+			if (!tangents.is_empty()) {
+				array[Mesh::ARRAY_TANGENT] = tangents;
+			}
+			if (!uv_array.is_empty()) {
+				array[Mesh::ARRAY_TEX_UV] = uv_array;
+			}
+			if (!uv2_array.is_empty()) {
+				array[Mesh::ARRAY_TEX_UV2] = uv2_array;
+			}
+			for (int custom_i = 0; custom_i < 3; custom_i++) {
+				if (!customs[custom_i].is_empty()) {
+					array[Mesh::ARRAY_CUSTOM0 + custom_i] = customs[custom_i];
+				}
+			}
+			if (!colors.is_empty()) {
+				array[Mesh::ARRAY_COLOR] = colors;
+			}
+			if (num_skin_weights > 0) {
+				array[Mesh::ARRAY_BONES] = bones;
+				array[Mesh::ARRAY_WEIGHTS] = weights;
+			}
+			array[Mesh::ARRAY_INDEX] = index_array;
+
+			Array morphs;
+			//blend shapes
+			if (use_blend_shapes) {
+				ERR_FAIL_COND_V(vertex_num == 0, ERR_PARSE_ERROR);
+
+				// Map every FBX vertex to the welded surface vertices created from it, so that each
+				// blend shape only has to visit the vertices it actually moves.
+				const uint32_t num_fbx_vertices = uint32_t(p_mesh->num_vertices);
+				LocalVector<uint32_t> source_first;
+				LocalVector<uint32_t> source_vertices;
+				source_first.resize(num_fbx_vertices + 1);
+				source_vertices.resize(vertex_num);
+				memset(source_first.ptr(), 0, source_first.size() * sizeof(uint32_t));
+				for (int i = 0; i < vertex_num; i++) {
+					source_first[vertex_sources[i] + 1]++;
+				}
+				for (uint32_t i = 0; i < num_fbx_vertices; i++) {
+					source_first[i + 1] += source_first[i];
+				}
+				{
+					LocalVector<uint32_t> source_fill = source_first;
+					for (int i = 0; i < vertex_num; i++) {
+						source_vertices[source_fill[vertex_sources[i]]++] = uint32_t(i);
+					}
+				}
+
+				// Triangles touching each vertex, only needed to regenerate tangents around moved vertices.
+				const int num_triangles = index_array.size() / 3;
+				LocalVector<uint32_t> triangle_first;
+				LocalVector<uint32_t> vertex_triangles;
+				LocalVector<uint32_t> vertex_stamps;
+				LocalVector<uint32_t> triangle_stamps;
+				LocalVector<uint32_t> ring_stamps;
+				if (generate_tangents) {
+					triangle_first.resize(vertex_num + 1);
+					vertex_triangles.resize(index_array.size());
+					memset(triangle_first.ptr(), 0, triangle_first.size() * sizeof(uint32_t));
+					for (int i = 0; i < index_array.size(); i++) {
+						triangle_first[index_array[i] + 1]++;
+					}
+					for (int i = 0; i < vertex_num; i++) {
+						triangle_first[i + 1] += triangle_first[i];
+					}
+					LocalVector<uint32_t> triangle_fill = triangle_first;
+					for (int i = 0; i < index_array.size(); i++) {
+						vertex_triangles[triangle_fill[index_array[i]]++] = uint32_t(i / 3);
+					}
+					vertex_stamps.resize(vertex_num);
+					triangle_stamps.resize(num_triangles);
+					ring_stamps.resize(num_triangles);
+					memset(vertex_stamps.ptr(), 0, vertex_stamps.size() * sizeof(uint32_t));
+					memset(triangle_stamps.ptr(), 0, triangle_stamps.size() * sizeof(uint32_t));
+					memset(ring_stamps.ptr(), 0, ring_stamps.size() * sizeof(uint32_t));
+				}
+
+				uint32_t shape_stamp = 0;
+				LocalVector<uint32_t> moved_vertices;
+				LocalVector<uint32_t> changed_triangles;
+				LocalVector<uint32_t> changed_vertices;
+				LocalVector<int> tangent_faces;
+				for (const ufbx_blend_deformer *fbx_deformer : p_mesh->blend_deformers) {
+					for (const ufbx_blend_channel *fbx_channel : fbx_deformer->channels) {
+						if (fbx_channel->keyframes.count == 0) {
+							continue;
+						}
+
+						// Use the last shape keyframe by default
+						ufbx_blend_shape *fbx_shape = fbx_channel->keyframes[fbx_channel->keyframes.count - 1].shape;
+						shape_stamp++;
+
+						// Blend shapes are stored as complete arrays, start from the base surface
+						// and scatter the offsets into the welded vertices that use them.
+						Vector<Vector3> varr = vertices;
+						Vector<Vector3> narr = normals;
+						Vector3 *w_varr = varr.ptrw();
+						Vector3 *w_narr = narr.ptrw();
+						const Vector3 *r_narr = normals.ptr();
+						const bool has_normal_offsets = fbx_shape->normal_offsets.count > 0;
+
+						moved_vertices.clear();
+						for (size_t offset_i = 0; offset_i < fbx_shape->num_offsets; offset_i++) {
+							const uint32_t vertex_index = fbx_shape->offset_vertices[offset_i];
+							if (vertex_index >= num_fbx_vertices) {
+								continue;
+							}
+							const Vector3 position_offset = _as_vec3(fbx_shape->position_offsets[offset_i]);
+							Vector3 normal_offset;
+							if (has_normal_offsets && offset_i < fbx_shape->normal_offsets.count) {
+								normal_offset = _as_vec3(fbx_shape->normal_offsets[offset_i]);
+							}
+							for (uint32_t i = source_first[vertex_index]; i < source_first[vertex_index + 1]; i++) {
+								const uint32_t l = source_vertices[i];
+								w_varr[l] = vertices[l] + position_offset;
+								if (has_normal_offsets && offset_i < fbx_shape->normal_offsets.count) {
+									w_narr[l] = (r_narr[l].normalized() + normal_offset).normalized();
+								}
+								moved_vertices.push_back(l);
+							}
+						}
+
+						// Enforce blend shape mask array format
+						Array morph;
+						morph.resize(Mesh::ARRAY_MAX);
+						morph[Mesh::ARRAY_VERTEX] = varr;
+						morph[Mesh::ARRAY_NORMAL] = narr;
+						if (generate_tangents) {
+							Vector<float> tarr = tangents;
+							if (!moved_vertices.is_empty()) {
+								// The tangent of a vertex depends on the triangles around it, so every vertex
+								// of a triangle touching a moved vertex may change. Those are regenerated from
+								// their complete triangle fans and all other tangents are kept from the base.
+								changed_triangles.clear();
+								for (uint32_t moved : moved_vertices) {
+									for (uint32_t i = triangle_first[moved]; i < triangle_first[moved + 1]; i++) {
+										const uint32_t triangle = vertex_triangles[i];
+										if (triangle_stamps[triangle] != shape_stamp) {
+											triangle_stamps[triangle] = shape_stamp;
+											changed_triangles.push_back(triangle);
+										}
+									}
+								}
+								changed_vertices.clear();
+								for (uint32_t triangle : changed_triangles) {
+									for (int corner = 0; corner < 3; corner++) {
+										const uint32_t vertex = uint32_t(index_array[triangle * 3 + corner]);
+										if (vertex_stamps[vertex] != shape_stamp) {
+											vertex_stamps[vertex] = shape_stamp;
+											changed_vertices.push_back(vertex);
+										}
+									}
+								}
+								tangent_faces.clear();
+								for (uint32_t vertex : changed_vertices) {
+									for (uint32_t i = triangle_first[vertex]; i < triangle_first[vertex + 1]; i++) {
+										const uint32_t triangle = vertex_triangles[i];
+										if (ring_stamps[triangle] != shape_stamp) {
+											ring_stamps[triangle] = shape_stamp;
+											tangent_faces.push_back(int(triangle));
+										}
+									}
+								}
+
+								FBXTangentContext context;
+								context.vertices = varr.ptr();
+								context.normals = narr.ptr();
+								context.uvs = uv_array.ptr();
+								context.indices = index_array.ptr();
+								context.tangents = tarr.ptrw();
+								context.faces = tangent_faces.ptr();
+								context.num_faces = int(tangent_faces.size());
+								context.write_stamps = vertex_stamps.ptr();
+								context.write_stamp = shape_stamp;
+								_generate_tangents(context);
+							}
+							morph[Mesh::ARRAY_TANGENT] = tarr;
+						} else if (!tangents.is_empty()) {
+							morph[Mesh::ARRAY_TANGENT] = tangents;
+						}
+
+						morphs.push_back(morph);
+					}
+				}
+			}
+
+			if (p_state->compress_vertex_attributes) {
+				_compress_surface_attributes(p_state->vertex_compression_max_error, array, morphs, flags);
+			}
+
+			MeshSurface surface;
+			surface.primitive = primitive;
+			surface.arrays = array;
+			surface.morphs = morphs;
+			surface.flags = flags;
+			surface.material_part = fbx_mesh_part.index;
+			surface.has_vertex_color = has_vertex_color;
+			r_mesh.surfaces.push_back(surface);
+		}
+	}
+
+	return OK;
+}
+
+void FBXDocument::_parse_mesh_surfaces_task(uint32_t p_index, ParseMeshesTask *p_task) {
+	const ufbx_mesh *fbx_mesh = p_task->scene->meshes[p_index];
+	ParsedMesh &parsed_mesh = p_task->meshes.write[p_index];
+	const bool selected = p_task->state->selected_meshes.is_empty() || p_task->state->selected_meshes[p_index];
+	if (selected && !cancel_requested.is_set()) {
+		if (p_task->profile) {
+			_begin_profile_entry(parsed_mesh.profile);
+		}
+		parsed_mesh.error = _parse_mesh_surfaces(p_task->state, fbx_mesh, parsed_mesh);
+		if (p_task->profile) {
+			_end_profile_entry(parsed_mesh.profile);
+		}
+	}
+	p_task->completed.increment();
+}
+
 Error FBXDocument::_parse_meshes(Ref<FBXState> p_state) {
 	ufbx_scene *fbx_scene = p_state->scene.get();
 
-	for (const ufbx_mesh *fbx_mesh : fbx_scene->meshes) {
+	// Build the surfaces of every mesh on worker threads. Everything that touches the
+	// shared state (unique names, materials, node skins) happens afterwards in mesh order.
+	ParseMeshesTask task;
+	task.state = p_state.ptr();
+	task.scene = fbx_scene;
+	task.meshes.resize(fbx_scene->meshes.count);
+	task.profile = p_state->profiling_enabled && p_state->detailed_profiling;
+
+	Vector<uint8_t> cache_key;
+	const String cache_file = _get_cache_file(p_state, "meshes", vformat("%d;%d;%d;%f;%s", p_state->discard_meshes_and_materials, p_state->quantize_skin_weights, p_state->compress_vertex_attributes, p_state->vertex_compression_max_error, String(";").join(p_state->node_filter)), cache_key);
+	const bool cached = !cache_file.is_empty() && _load_cached_meshes(cache_file, cache_key, task.meshes);
+	if (cached) {
+		print_verbose("FBX: Loaded cached meshes from: " + cache_file);
+	} else if (fbx_scene->meshes.count > 0) {
+		WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &FBXDocument::_parse_mesh_surfaces_task, &task, int(fbx_scene->meshes.count), -1, true, SNAME("FBXParseMeshes"));
+		_wait_for_group_task(group_id, PROGRESS_STAGE_MESHES, task.completed, uint32_t(fbx_scene->meshes.count));
+		if (!cache_file.is_empty() && !cancel_requested.is_set()) {
+			_save_cached_meshes(cache_file, cache_key, task.meshes);
+		}
+	}
+	if (cancel_requested.is_set()) {
+		return OK;
+	}
+
+	for (int mesh_i = 0; mesh_i < static_cast<int>(fbx_scene->meshes.count); mesh_i++) {
+		const ufbx_mesh *fbx_mesh = fbx_scene->meshes[mesh_i];
+		const ParsedMesh &parsed_mesh = task.meshes[mesh_i];
 		print_verbose("FBX: Parsing mesh: " + itos(int64_t(fbx_mesh->typed_id)));
-
-		static const Mesh::PrimitiveType primitive_types[] = {
-			Mesh::PRIMITIVE_TRIANGLES,
-			Mesh::PRIMITIVE_POINTS,
-			Mesh::PRIMITIVE_LINES,
-		};
+		ERR_FAIL_COND_V(parsed_mesh.error != OK, parsed_mesh.error);
 
 		Ref<ImporterMesh> import_mesh;
 		import_mesh.instantiate();
@@ -445,6 +1567,23 @@ Error FBXDocument::_parse_meshes(Ref<FBXState> p_state) {
 		}
 		import_mesh->set_name(_gen_unique_name(p_state, mesh_name));
 
+		if (!p_state->selected_meshes.is_empty() && !p_state->selected_meshes[mesh_i]) {
+			// No selected node uses it, keep an empty mesh so indices don't change.
+			Ref<FBXMesh> mesh;
+			mesh.instantiate();
+			mesh->set_mesh(import_mesh);
+			p_state->meshes.push_back(mesh);
+			continue;
+		}
+
+		if (task.profile) {
+			FBXState::ProfileEntry entry = parsed_mesh.profile;
+			entry.name = import_mesh->get_name();
+			entry.category = "mesh";
+			entry.count = int64_t(fbx_mesh->num_vertices);
+			p_state->add_profile_entry(entry);
+		}
+
 		bool use_blend_shapes = false;
 		if (fbx_mesh->blend_deformers.count > 0) {
 			use_blend_shapes = true;
@@ -475,386 +1614,46 @@ Error FBXDocument::_parse_meshes(Ref<FBXState> p_state) {
 			}
 		}
 
-		for (const ufbx_mesh_part &fbx_mesh_part : fbx_mesh->material_parts) {
-			for (Mesh::PrimitiveType primitive : primitive_types) {
-				uint32_t num_indices = 0;
-				switch (primitive) {
-					case Mesh::PRIMITIVE_POINTS:
-						num_indices = fbx_mesh_part.num_point_faces * 1;
-						break;
-					case Mesh::PRIMITIVE_LINES:
-						num_indices = fbx_mesh_part.num_line_faces * 2;
-						break;
-					case Mesh::PRIMITIVE_TRIANGLES:
-						num_indices = fbx_mesh_part.num_triangles * 3;
-						break;
-					case Mesh::PRIMITIVE_TRIANGLE_STRIP:
-						// FIXME 2021-09-15 fire
-						break;
-					case Mesh::PRIMITIVE_LINE_STRIP:
-						// FIXME 2021-09-15 fire
-						break;
-					default:
-						// FIXME 2021-09-15 fire
-						break;
-				}
-				if (num_indices == 0) {
-					continue;
-				}
-
-				Vector<uint32_t> indices;
-				indices.resize(num_indices);
-
-				uint32_t offset = 0;
-				for (uint32_t face_index : fbx_mesh_part.face_indices) {
-					ufbx_face face = fbx_mesh->faces[face_index];
-					switch (primitive) {
-						case Mesh::PRIMITIVE_POINTS: {
-							if (face.num_indices == 1) {
-								indices.write[offset] = face.index_begin;
-								offset += 1;
-							}
-						} break;
-						case Mesh::PRIMITIVE_LINES:
-							if (face.num_indices == 2) {
-								indices.write[offset] = face.index_begin;
-								indices.write[offset + 1] = face.index_begin + 1;
-								offset += 2;
-							}
-							break;
-						case Mesh::PRIMITIVE_TRIANGLES:
-							if (face.num_indices >= 3) {
-								uint32_t *dst = indices.ptrw() + offset;
-								size_t space = indices.size() - offset;
-								uint32_t num_triangles = ufbx_triangulate_face(dst, space, fbx_mesh, face);
-								offset += num_triangles * 3;
-
-								// Godot uses clockwise winding order!
-								for (uint32_t i = 0; i < num_triangles; i++) {
-									SWAP(dst[i * 3 + 0], dst[i * 3 + 2]);
-								}
-							}
-							break;
-						case Mesh::PRIMITIVE_TRIANGLE_STRIP:
-							// FIXME 2021-09-15 fire
-							break;
-						case Mesh::PRIMITIVE_LINE_STRIP:
-							// FIXME 2021-09-15 fire
-							break;
-						default:
-							// FIXME 2021-09-15 fire
-							break;
-					}
-				}
-				ERR_CONTINUE((uint64_t)offset != (uint64_t)indices.size());
-
-				int32_t vertex_num = indices.size();
-				bool has_vertex_color = false;
-
-				uint32_t flags = 0;
-
-				Array array;
-				array.resize(Mesh::ARRAY_MAX);
-
-				// HACK: If we have blend shapes we cannot merge vertices at identical positions
-				// if they have different indices in the file. To avoid this encode the vertex index
-				// into the vertex position for the time being.
-				// Ideally this would be an extra channel in the vertex but as the vertex format is
-				// fixed and we already use user data for extra UV channels this'll do.
-				if (use_blend_shapes) {
-					Vector<Vector3> vertex_indices;
-					int num_blend_shape_indices = indices.size();
-					vertex_indices.resize(num_blend_shape_indices);
-					for (int i = 0; i < num_blend_shape_indices; i++) {
-						vertex_indices.write[i] = _encode_vertex_index(fbx_mesh->vertex_indices[indices[i]]);
-					}
-					array[Mesh::ARRAY_VERTEX] = vertex_indices;
-				} else {
-					array[Mesh::ARRAY_VERTEX] = _decode_vertex_attrib_vec3(fbx_mesh->vertex_position, indices);
-				}
-
-				// Normals always exist as they're generated if missing,
-				// see `ufbx_load_opts.generate_missing_normals`.
-				Vector<Vector3> normals = _decode_vertex_attrib_vec3(fbx_mesh->vertex_normal, indices);
-				array[Mesh::ARRAY_NORMAL] = normals;
-
-				if (fbx_mesh->vertex_tangent.exists) {
-					Vector<float> tangents = _decode_vertex_attrib_vec3_as_tangent(fbx_mesh->vertex_tangent, indices);
-
-					// Patch bitangent sign if available
-					if (fbx_mesh->vertex_bitangent.exists) {
-						for (int i = 0; i < vertex_num; i++) {
-							Vector3 tangent = Vector3(tangents[i * 4], tangents[i * 4 + 1], tangents[i * 4 + 2]);
-							Vector3 bitangent = _as_vec3(fbx_mesh->vertex_bitangent[indices[i]]);
-							Vector3 generated_bitangent = normals[i].cross(tangent);
-							if (generated_bitangent.dot(bitangent) < 0.0f) {
-								tangents.write[i * 4 + 3] = -1.0f;
-							}
-						}
-					}
-
-					array[Mesh::ARRAY_TANGENT] = tangents;
-				}
-
-				if (fbx_mesh->vertex_uv.exists) {
-					PackedVector2Array uv_array = _decode_vertex_attrib_vec2(fbx_mesh->vertex_uv, indices);
-					_process_uv_set(uv_array);
-					array[Mesh::ARRAY_TEX_UV] = uv_array;
-				}
-
-				if (fbx_mesh->uv_sets.count >= 2 && fbx_mesh->uv_sets[1].vertex_uv.exists) {
-					PackedVector2Array uv2_array = _decode_vertex_attrib_vec2(fbx_mesh->uv_sets[1].vertex_uv, indices);
-					_process_uv_set(uv2_array);
-					array[Mesh::ARRAY_TEX_UV2] = uv2_array;
-				}
-
-				for (int uv_i = 2; uv_i < 8; uv_i += 2) {
-					Vector<float> cur_custom;
-					Vector<Vector2> texcoord_first;
-					Vector<Vector2> texcoord_second;
-
-					int texcoord_i = uv_i;
-					int texcoord_next = texcoord_i + 1;
-					int num_channels = 0;
-					if (texcoord_i < static_cast<int>(fbx_mesh->uv_sets.count) && fbx_mesh->uv_sets[texcoord_i].vertex_uv.exists) {
-						texcoord_first = _decode_vertex_attrib_vec2(fbx_mesh->uv_sets[texcoord_i].vertex_uv, indices);
-						_process_uv_set(texcoord_first);
-						num_channels = 2;
-					}
-					if (texcoord_next < static_cast<int>(fbx_mesh->uv_sets.count) && fbx_mesh->uv_sets[texcoord_next].vertex_uv.exists) {
-						texcoord_second = _decode_vertex_attrib_vec2(fbx_mesh->uv_sets[texcoord_next].vertex_uv, indices);
-						_process_uv_set(texcoord_second);
-						num_channels = 4;
-					}
-					if (!num_channels) {
-						break;
-					}
-					cur_custom.resize(vertex_num * num_channels);
-					for (int32_t uv_first_i = 0; uv_first_i < texcoord_first.size() && uv_first_i < vertex_num; uv_first_i++) {
-						int index = uv_first_i * num_channels;
-						cur_custom.write[index] = texcoord_first[uv_first_i].x;
-						cur_custom.write[index + 1] = texcoord_first[uv_first_i].y;
-					}
-					if (num_channels == 4) {
-						for (int32_t uv_second_i = 0; uv_second_i < texcoord_second.size() && uv_second_i < vertex_num; uv_second_i++) {
-							int index = uv_second_i * num_channels;
-							cur_custom.write[index + 2] = texcoord_second[uv_second_i].x;
-							cur_custom.write[index + 3] = texcoord_second[uv_second_i].y;
-						}
-						_zero_unused_elements(cur_custom, texcoord_second.size(), vertex_num, num_channels);
-					} else if (num_channels == 2) {
-						_zero_unused_elements(cur_custom, texcoord_first.size(), vertex_num, num_channels);
-					}
-					if (!cur_custom.is_empty()) {
-						array[Mesh::ARRAY_CUSTOM0 + ((uv_i - 2) / 2)] = cur_custom; // Map uv2-uv7 to custom0-custom2
-						int custom_shift = Mesh::ARRAY_FORMAT_CUSTOM0_SHIFT + ((uv_i - 2) / 2) * Mesh::ARRAY_FORMAT_CUSTOM_BITS;
-						flags |= (num_channels == 2 ? Mesh::ARRAY_CUSTOM_RG_FLOAT : Mesh::ARRAY_CUSTOM_RGBA_FLOAT) << custom_shift;
-					}
-				}
-
-				if (fbx_mesh->vertex_color.exists) {
-					array[Mesh::ARRAY_COLOR] = _decode_vertex_attrib_color(fbx_mesh->vertex_color, indices);
-					has_vertex_color = true;
-				}
-
-				int32_t num_skin_weights = 0;
-
-				// Find the first imported skin deformer
-				for (ufbx_skin_deformer *fbx_skin : fbx_mesh->skin_deformers) {
-					FBXSkinIndex skin_i = p_state->skin_indices[fbx_skin->typed_id];
-					if (skin_i < 0) {
-						continue;
-					}
-
-					// Tag all nodes to use the skin
-					for (const ufbx_node *node : fbx_mesh->instances) {
-						p_state->nodes[node->typed_id]->skin = skin_i;
-					}
-
-					num_skin_weights = fbx_skin->max_weights_per_vertex > 4 ? 8 : 4;
-
-					Vector<int32_t> bones;
-					Vector<float> weights;
-
-					bones.resize(vertex_num * num_skin_weights);
-					weights.resize(vertex_num * num_skin_weights);
-					for (int32_t vertex_i = 0; vertex_i < vertex_num; vertex_i++) {
-						uint32_t fbx_vertex_index = fbx_mesh->vertex_indices[indices[vertex_i]];
-						ufbx_skin_vertex skin_vertex = fbx_skin->vertices[fbx_vertex_index];
-						float total_weight = 0.0f;
-						int32_t num_weights = MIN(int32_t(skin_vertex.num_weights), num_skin_weights);
-						for (int32_t i = 0; i < num_weights; i++) {
-							ufbx_skin_weight skin_weight = fbx_skin->weights[skin_vertex.weight_begin + i];
-							int index = vertex_i * num_skin_weights + i;
-							float weight = float(skin_weight.weight);
-							bones.write[index] = int(skin_weight.cluster_index);
-							weights.write[index] = weight;
-							total_weight += weight;
-						}
-						if (total_weight > 0.0f) {
-							for (int32_t i = 0; i < num_weights; i++) {
-								int index = vertex_i * num_skin_weights + i;
-								weights.write[index] /= total_weight;
-							}
-						}
-						// Pad the rest with empty weights
-						for (int32_t i = num_weights; i < num_skin_weights; i++) {
-							int index = vertex_i * num_skin_weights + i;
-							bones.write[index] = 0; // TODO: What should this be padded with?
-							weights.write[index] = 0.0f;
-						}
-					}
-					array[Mesh::ARRAY_BONES] = bones;
-					array[Mesh::ARRAY_WEIGHTS] = weights;
-
-					if (num_skin_weights == 8) {
-						flags |= Mesh::ARRAY_FLAG_USE_8_BONE_WEIGHTS;
-					}
-
-					// Only use the first found skin
-					break;
-				}
-
-				bool generate_tangents = (primitive == Mesh::PRIMITIVE_TRIANGLES && !array[Mesh::ARRAY_TANGENT] && array[Mesh::ARRAY_TEX_UV] && array[Mesh::ARRAY_NORMAL]);
-
-				Ref<SurfaceTool> mesh_surface_tool;
-				mesh_surface_tool.instantiate();
-				mesh_surface_tool->create_from_triangle_arrays(array);
-				mesh_surface_tool->set_skin_weight_count(num_skin_weights == 8 ? SurfaceTool::SKIN_8_WEIGHTS : SurfaceTool::SKIN_4_WEIGHTS);
-				mesh_surface_tool->index();
-				if (generate_tangents) {
-					//must generate mikktspace tangents.. ergh..
-					mesh_surface_tool->generate_tangents();
-				}
-				array = mesh_surface_tool->commit_to_arrays();
-
-				Array morphs;
-				//blend shapes
-				if (use_blend_shapes) {
-					print_verbose("FBX: Mesh has targets");
-
-					import_mesh->set_blend_shape_mode(Mesh::BLEND_SHAPE_MODE_NORMALIZED);
-
-					for (const ufbx_blend_deformer *fbx_deformer : fbx_mesh->blend_deformers) {
-						for (const ufbx_blend_channel *fbx_channel : fbx_deformer->channels) {
-							if (fbx_channel->keyframes.count == 0) {
-								continue;
-							}
-
-							// Use the last shape keyframe by default
-							ufbx_blend_shape *fbx_shape = fbx_channel->keyframes[fbx_channel->keyframes.count - 1].shape;
-
-							Array array_copy;
-							array_copy.resize(Mesh::ARRAY_MAX);
-
-							for (int l = 0; l < Mesh::ARRAY_MAX; l++) {
-								array_copy[l] = array[l];
-							}
-
-							Vector<Vector3> varr;
-							Vector<Vector3> narr;
-							const Vector<Vector3> src_varr = array[Mesh::ARRAY_VERTEX];
-							const Vector<Vector3> src_narr = array[Mesh::ARRAY_NORMAL];
-							const int size = src_varr.size();
-							ERR_FAIL_COND_V(size == 0, ERR_PARSE_ERROR);
-							{
-								varr.resize(size);
-								narr.resize(size);
-
-								Vector3 *w_varr = varr.ptrw();
-								Vector3 *w_narr = narr.ptrw();
-								const Vector3 *r_varr = src_varr.ptr();
-								const Vector3 *r_narr = src_narr.ptr();
-								for (int l = 0; l < size; l++) {
-									uint32_t vertex_index = _decode_vertex_index(r_varr[l]);
-									uint32_t offset_index = ufbx_get_blend_shape_offset_index(fbx_shape, vertex_index);
-									Vector3 position = _as_vec3(fbx_mesh->vertices[vertex_index]);
-									Vector3 normal = r_narr[l];
-
-									if (offset_index != UFBX_NO_INDEX && offset_index < fbx_shape->position_offsets.count) {
-										Vector3 blend_shape_position_offset = _as_vec3(fbx_shape->position_offsets[offset_index]);
-										w_varr[l] = position + blend_shape_position_offset;
-									} else {
-										w_varr[l] = position;
-									}
-
-									if (offset_index != UFBX_NO_INDEX && offset_index < fbx_shape->normal_offsets.count) {
-										w_narr[l] = (normal.normalized() + _as_vec3(fbx_shape->normal_offsets[offset_index])).normalized();
-									} else {
-										w_narr[l] = normal;
-									}
-								}
-							}
-							array_copy[Mesh::ARRAY_VERTEX] = varr;
-							array_copy[Mesh::ARRAY_NORMAL] = narr;
-
-							Ref<SurfaceTool> blend_surface_tool;
-							blend_surface_tool.instantiate();
-							blend_surface_tool->create_from_triangle_arrays(array_copy);
-							blend_surface_tool->set_skin_weight_count(num_skin_weights == 8 ? SurfaceTool::SKIN_8_WEIGHTS : SurfaceTool::SKIN_4_WEIGHTS);
-							if (generate_tangents) {
-								//must generate mikktspace tangents.. ergh..
-								blend_surface_tool->generate_tangents();
-							}
-							array_copy = blend_surface_tool->commit_to_arrays();
-
-							// Enforce blend shape mask array format
-							for (int l = 0; l < Mesh::ARRAY_MAX; l++) {
-								if (!(Mesh::ARRAY_FORMAT_BLEND_SHAPE_MASK & (static_cast<int64_t>(1) << l))) {
-									array_copy[l] = Variant();
-								}
-							}
-
-							morphs.push_back(array_copy);
-						}
-					}
-				}
+		// Tag all nodes to use the skin
+		if (parsed_mesh.skin >= 0) {
+			for (const ufbx_node *node : fbx_mesh->instances) {
+				p_state->node_table.skins[node->typed_id] = parsed_mesh.skin;
+			}
+		}
 
-				// Decode the original vertex positions now that we're done processing blend shapes.
-				if (use_blend_shapes) {
-					Vector<Vector3> varr = array[Mesh::ARRAY_VERTEX];
-					Vector3 *w_varr = varr.ptrw();
-					const int size = varr.size();
-					for (int i = 0; i < size; i++) {
-						uint32_t vertex_index = _decode_vertex_index(w_varr[i]);
-						w_varr[i] = _as_vec3(fbx_mesh->vertices[vertex_index]);
-					}
-					array[Mesh::ARRAY_VERTEX] = varr;
+		for (const MeshSurface &surface : parsed_mesh.surfaces) {
+			Ref<Material> mat;
+			String mat_name;
+			if (!p_state->discard_meshes_and_materials) {
+				ufbx_material *fbx_material = nullptr;
+				if (surface.material_part < fbx_mesh->materials.count) {
+					fbx_material = fbx_mesh->materials[surface.material_part];
 				}
-
-				Ref<Material> mat;
-				String mat_name;
-				if (!p_state->discard_meshes_and_materials) {
-					ufbx_material *fbx_material = nullptr;
-					if (fbx_mesh_part.index < fbx_mesh->materials.count) {
-						fbx_material = fbx_mesh->materials[fbx_mesh_part.index];
+				if (fbx_material) {
+					const int material = int(fbx_material->typed_id);
+					ERR_FAIL_INDEX_V(material, p_state->materials.size(), ERR_FILE_CORRUPT);
+					Ref<Material> mat3d = p_state->materials[material];
+					ERR_FAIL_NULL_V(mat3d, ERR_FILE_CORRUPT);
+
+					Ref<BaseMaterial3D> base_material = mat3d;
+					if (surface.has_vertex_color && base_material.is_valid()) {
+						base_material->set_flag(BaseMaterial3D::FLAG_ALBEDO_FROM_VERTEX_COLOR, true);
 					}
-					if (fbx_material) {
-						const int material = int(fbx_material->typed_id);
-						ERR_FAIL_INDEX_V(material, p_state->materials.size(), ERR_FILE_CORRUPT);
-						Ref<Material> mat3d = p_state->materials[material];
-						ERR_FAIL_NULL_V(mat3d, ERR_FILE_CORRUPT);
-
-						Ref<BaseMaterial3D> base_material = mat3d;
-						if (has_vertex_color && base_material.is_valid()) {
-							base_material->set_flag(BaseMaterial3D::FLAG_ALBEDO_FROM_VERTEX_COLOR, true);
-						}
-						mat = mat3d;
+					mat = mat3d;
 
-					} else {
-						Ref<StandardMaterial3D> mat3d;
-						mat3d.instantiate();
-						if (has_vertex_color) {
-							mat3d->set_flag(StandardMaterial3D::FLAG_ALBEDO_FROM_VERTEX_COLOR, true);
-						}
-						mat = mat3d;
+				} else {
+					Ref<StandardMaterial3D> mat3d;
+					mat3d.instantiate();
+					if (surface.has_vertex_color) {
+						mat3d->set_flag(StandardMaterial3D::FLAG_ALBEDO_FROM_VERTEX_COLOR, true);
 					}
-					ERR_FAIL_NULL_V(mat, ERR_FILE_CORRUPT);
-					mat_name = mat->get_name();
+					mat = mat3d;
 				}
-				import_mesh->add_surface(primitive, array, morphs,
-						Dictionary(), mat, mat_name, flags);
+				ERR_FAIL_NULL_V(mat, ERR_FILE_CORRUPT);
+				mat_name = mat->get_name();
 			}
+			import_mesh->add_surface(surface.primitive, surface.arrays, surface.morphs,
+					Dictionary(), mat, mat_name, surface.flags);
 		}
 
 		Ref<FBXMesh> mesh;
@@ -871,119 +1670,171 @@ Error FBXDocument::_parse_meshes(Ref<FBXState> p_state) {
 	return OK;
 }
 
-Ref<Image> FBXDocument::_parse_image_bytes_into_image(Ref<FBXState> p_state, const Vector<uint8_t> &p_bytes, const String &p_filename, int p_index) {
-	Ref<Image> r_image;
-	r_image.instantiate();
-	// Try to import first based on filename.
+static String _md5_text(const uint8_t *p_data, size_t p_size) {
+	unsigned char md5_hash[16];
+	CryptoCore::md5(p_data, int(p_size), md5_hash);
+	return String::hex_encode_buffer(md5_hash, 16);
+}
+
+static String _image_data_md5(const Vector<uint8_t> &p_data) {
+	return _md5_text(p_data.ptr(), size_t(p_data.size()));
+}
+
+// Decodes an image straight from memory by trying the format suggested by the filename first.
+// Only uses the reentrant image loaders, so this is safe to call from worker threads.
+static Ref<Image> _load_image_from_memory(const uint8_t *p_data, int p_size, const String &p_filename) {
+	Image::ImageMemLoadFunc loaders[3] = { Image::_png_mem_loader_func, Image::_jpg_mem_loader_func, Image::_tga_mem_loader_func };
 	String filename_lower = p_filename.to_lower();
-	if (filename_lower.ends_with(".png")) {
-		r_image->load_png_from_buffer(p_bytes);
-	} else if (filename_lower.ends_with(".jpg")) {
-		r_image->load_jpg_from_buffer(p_bytes);
+	if (filename_lower.ends_with(".jpg") || filename_lower.ends_with(".jpeg")) {
+		SWAP(loaders[0], loaders[1]);
 	} else if (filename_lower.ends_with(".tga")) {
-		r_image->load_tga_from_buffer(p_bytes);
+		SWAP(loaders[0], loaders[2]);
+	}
+	for (Image::ImageMemLoadFunc loader : loaders) {
+		if (!loader || p_size <= 0) {
+			continue;
+		}
+		Ref<Image> image = loader(p_data, p_size);
+		if (image.is_valid() && !image->is_empty()) {
+			return image;
+		}
 	}
-	// If we didn't pass the above tests, try loading as each option.
-	if (r_image->is_empty()) { // Try PNG first.
-		r_image->load_png_from_buffer(p_bytes);
+	return Ref<Image>();
+}
+
+FBXImageIndex FBXDocument::_store_image(Ref<FBXState> p_state, FBXImageIndex p_slot, const Ref<Texture2D> &p_texture, const Ref<Image> &p_source_image) {
+	if (p_slot < 0) {
+		p_state->images.push_back(p_texture);
+		p_state->source_images.push_back(p_source_image);
+		return p_state->images.size() - 1;
 	}
-	if (r_image->is_empty()) { // And then JPEG.
-		r_image->load_jpg_from_buffer(p_bytes);
+	ERR_FAIL_INDEX_V(p_slot, p_state->images.size(), -1);
+	p_state->images.write[p_slot] = p_texture;
+	p_state->source_images.write[p_slot] = p_source_image;
+	return p_slot;
+}
+
+#ifdef TOOLS_ENABLED
+FBXImageIndex FBXDocument::_extract_image(Ref<FBXState> p_state, const Vector<uint8_t> &p_bytes, const String &p_file_extension, int p_index, Ref<Image> p_image, const String &p_md5, FBXImageIndex p_slot) {
+	FBXImageIndex image_index = -1;
+	if (p_state->base_path.is_empty()) {
+		if (p_index < 0) {
+			return -1;
+		}
+		image_index = _store_image(p_state, p_slot, Ref<Texture2D>(), Ref<Image>());
+	} else if (p_image->get_name().is_empty()) {
+		if (p_index < 0) {
+			return -1;
+		}
+		WARN_PRINT(vformat("FBX: Image index '%d' couldn't be named. Skipping it.", p_index));
+		image_index = _store_image(p_state, p_slot, Ref<Texture2D>(), Ref<Image>());
+	} else {
+		bool must_import = true;
+		Vector<uint8_t> img_data = p_image->get_data();
+		Dictionary generator_parameters;
+		String file_path = p_state->get_base_path() + "/" + p_state->filename.get_basename() + "_" + p_image->get_name();
+		file_path += p_file_extension.is_empty() ? ".png" : p_file_extension;
+		if (FileAccess::exists(file_path + ".import")) {
+			Ref<ConfigFile> config;
+			config.instantiate();
+			config->load(file_path + ".import");
+			if (config->has_section_key("remap", "generator_parameters")) {
+				generator_parameters = (Dictionary)config->get_value("remap", "generator_parameters");
+			}
+			if (!generator_parameters.has("md5")) {
+				must_import = false; // Didn't come from a gltf document; don't overwrite.
+			}
+			String existing_md5 = generator_parameters["md5"];
+			String new_md5 = p_md5.is_empty() ? _image_data_md5(img_data) : p_md5;
+			generator_parameters["md5"] = new_md5;
+			if (new_md5 == existing_md5) {
+				must_import = false;
+			}
+		}
+		if (must_import) {
+			Error err = OK;
+			if (p_file_extension.is_empty()) {
+				// If a file extension was not specified, save the image data to a PNG file.
+				err = p_image->save_png(file_path);
+				ERR_FAIL_COND_V(err != OK, -1);
+			} else {
+				// If a file extension was specified, save the original bytes to a file with that extension.
+				Ref<FileAccess> file = FileAccess::open(file_path, FileAccess::WRITE, &err);
+				ERR_FAIL_COND_V(err != OK, -1);
+				file->store_buffer(p_bytes);
+				file->close();
+			}
+			// ResourceLoader::import will crash if not is_editor_hint(), so this case is protected above and will fall through to uncompressed.
+			HashMap<StringName, Variant> custom_options;
+			custom_options[SNAME("mipmaps/generate")] = true;
+			// Will only use project settings defaults if custom_importer is empty.
+			EditorFileSystem::get_singleton()->update_file(file_path);
+			EditorFileSystem::get_singleton()->reimport_append(file_path, custom_options, String(), generator_parameters);
+		}
+		Ref<Texture2D> saved_image = ResourceLoader::load(file_path, "Texture2D");
+		if (saved_image.is_valid()) {
+			image_index = _store_image(p_state, p_slot, saved_image, saved_image->get_image());
+		} else if (p_index < 0) {
+			return -1;
+		} else {
+			WARN_PRINT(vformat("FBX: Image index '%d' couldn't be loaded with the name: %s. Skipping it.", p_index, p_image->get_name()));
+			// Placeholder to keep count.
+			image_index = _store_image(p_state, p_slot, Ref<Texture2D>(), Ref<Image>());
+		}
 	}
-	if (r_image->is_empty()) { // And then TGA.
-		r_image->load_jpg_from_buffer(p_bytes);
+	return image_index;
+}
+
+void FBXDocument::_run_batch_image_extracts(BatchImport *p_batch) {
+	LocalVector<BatchImageExtract *> requests;
+	{
+		MutexLock lock(p_batch->mutex);
+		requests = p_batch->image_extracts;
+		p_batch->image_extracts.clear();
 	}
-	// If it still can't be loaded, give up and insert an empty image as placeholder.
-	if (r_image->is_empty()) {
-		ERR_PRINT(vformat("FBX: Couldn't load image index '%d'", p_index));
+	for (BatchImageExtract *request : requests) {
+		request->result = request->document->_extract_image(request->state, *request->bytes, request->file_extension, request->index, request->image, request->md5, request->slot);
+		request->done.post();
 	}
-	return r_image;
 }
 
-FBXImageIndex FBXDocument::_parse_image_save_image(Ref<FBXState> p_state, const Vector<uint8_t> &p_bytes, const String &p_file_extension, int p_index, Ref<Image> p_image) {
+void FBXDocument::_run_async_image_extracts() {
+	_run_batch_image_extracts(&async_batch);
+}
+#endif // TOOLS_ENABLED
+
+FBXImageIndex FBXDocument::_parse_image_save_image(Ref<FBXState> p_state, const Vector<uint8_t> &p_bytes, const String &p_file_extension, int p_index, Ref<Image> p_image, const String &p_md5, FBXImageIndex p_slot) {
 	FBXState::FBXHandleBinary handling = FBXState::FBXHandleBinary(p_state->handle_binary_image);
 	if (p_image->is_empty() || handling == FBXState::FBXHandleBinary::HANDLE_BINARY_DISCARD_TEXTURES) {
 		if (p_index < 0) {
 			return -1;
 		}
-		p_state->images.push_back(Ref<Texture2D>());
-		p_state->source_images.push_back(Ref<Image>());
-		return p_state->images.size() - 1;
+		return _store_image(p_state, p_slot, Ref<Texture2D>(), Ref<Image>());
 	}
 #ifdef TOOLS_ENABLED
 	if (Engine::get_singleton()->is_editor_hint() && handling == FBXState::FBXHandleBinary::HANDLE_BINARY_EXTRACT_TEXTURES) {
-		if (p_state->base_path.is_empty()) {
-			if (p_index < 0) {
-				return -1;
-			}
-			p_state->images.push_back(Ref<Texture2D>());
-			p_state->source_images.push_back(Ref<Image>());
-		} else if (p_image->get_name().is_empty()) {
-			if (p_index < 0) {
-				return -1;
-			}
-			WARN_PRINT(vformat("FBX: Image index '%d' couldn't be named. Skipping it.", p_index));
-			p_state->images.push_back(Ref<Texture2D>());
-			p_state->source_images.push_back(Ref<Image>());
-		} else {
-			bool must_import = true;
-			Vector<uint8_t> img_data = p_image->get_data();
-			Dictionary generator_parameters;
-			String file_path = p_state->get_base_path() + "/" + p_state->filename.get_basename() + "_" + p_image->get_name();
-			file_path += p_file_extension.is_empty() ? ".png" : p_file_extension;
-			if (FileAccess::exists(file_path + ".import")) {
-				Ref<ConfigFile> config;
-				config.instantiate();
-				config->load(file_path + ".import");
-				if (config->has_section_key("remap", "generator_parameters")) {
-					generator_parameters = (Dictionary)config->get_value("remap", "generator_parameters");
-				}
-				if (!generator_parameters.has("md5")) {
-					must_import = false; // Didn't come from a gltf document; don't overwrite.
-				}
-				String existing_md5 = generator_parameters["md5"];
-				unsigned char md5_hash[16];
-				CryptoCore::md5(img_data.ptr(), img_data.size(), md5_hash);
-				String new_md5 = String::hex_encode_buffer(md5_hash, 16);
-				generator_parameters["md5"] = new_md5;
-				if (new_md5 == existing_md5) {
-					must_import = false;
-				}
+		if (batch && batch->thread_id != Thread::get_caller_id()) {
+			// The editor filesystem is only used from the thread that runs `append_from_files()`.
+			BatchImageExtract request;
+			request.document = this;
+			request.state = p_state;
+			request.bytes = &p_bytes;
+			request.file_extension = p_file_extension;
+			request.index = p_index;
+			request.image = p_image;
+			request.md5 = p_md5;
+			request.slot = p_slot;
+			{
+				MutexLock lock(batch->mutex);
+				batch->image_extracts.push_back(&request);
 			}
-			if (must_import) {
-				Error err = OK;
-				if (p_file_extension.is_empty()) {
-					// If a file extension was not specified, save the image data to a PNG file.
-					err = p_image->save_png(file_path);
-					ERR_FAIL_COND_V(err != OK, -1);
-				} else {
-					// If a file extension was specified, save the original bytes to a file with that extension.
-					Ref<FileAccess> file = FileAccess::open(file_path, FileAccess::WRITE, &err);
-					ERR_FAIL_COND_V(err != OK, -1);
-					file->store_buffer(p_bytes);
-					file->close();
-				}
-				// ResourceLoader::import will crash if not is_editor_hint(), so this case is protected above and will fall through to uncompressed.
-				HashMap<StringName, Variant> custom_options;
-				custom_options[SNAME("mipmaps/generate")] = true;
-				// Will only use project settings defaults if custom_importer is empty.
-				EditorFileSystem::get_singleton()->update_file(file_path);
-				EditorFileSystem::get_singleton()->reimport_append(file_path, custom_options, String(), generator_parameters);
-			}
-			Ref<Texture2D> saved_image = ResourceLoader::load(file_path, "Texture2D");
-			if (saved_image.is_valid()) {
-				p_state->images.push_back(saved_image);
-				p_state->source_images.push_back(saved_image->get_image());
-			} else if (p_index < 0) {
-				return -1;
-			} else {
-				WARN_PRINT(vformat("FBX: Image index '%d' couldn't be loaded with the name: %s. Skipping it.", p_index, p_image->get_name()));
-				// Placeholder to keep count.
-				p_state->images.push_back(Ref<Texture2D>());
-				p_state->source_images.push_back(Ref<Image>());
+			if (batch->deferred_image_extracts) {
+				callable_mp(batch->owner, &FBXDocument::_run_async_image_extracts).call_deferred();
 			}
+			request.done.wait();
+			return request.result;
 		}
-		return p_state->images.size() - 1;
+		return _extract_image(p_state, p_bytes, p_file_extension, p_index, p_image, p_md5, p_slot);
 	}
 #endif // TOOLS_ENABLED
 	if (handling == FBXState::FBXHandleBinary::HANDLE_BINARY_EMBED_AS_BASISU) {
@@ -992,9 +1843,7 @@ FBXImageIndex FBXDocument::_parse_image_save_image(Ref<FBXState> p_state, const
 		tex->set_name(p_image->get_name());
 		tex->set_keep_compressed_buffer(true);
 		tex->create_from_image(p_image, PortableCompressedTexture2D::COMPRESSION_MODE_BASIS_UNIVERSAL);
-		p_state->images.push_back(tex);
-		p_state->source_images.push_back(p_image);
-		return p_state->images.size() - 1;
+		return _store_image(p_state, p_slot, tex, p_image);
 	}
 	// This handles the case of HANDLE_BINARY_EMBED_AS_UNCOMPRESSED, and it also serves
 	// as a fallback for HANDLE_BINARY_EXTRACT_TEXTURES when this is not the editor.
@@ -1002,46 +1851,237 @@ FBXImageIndex FBXDocument::_parse_image_save_image(Ref<FBXState> p_state, const
 	tex.instantiate();
 	tex->set_name(p_image->get_name());
 	tex->set_image(p_image);
-	p_state->images.push_back(tex);
-	p_state->source_images.push_back(p_image);
-	return p_state->images.size() - 1;
+	return _store_image(p_state, p_slot, tex, p_image);
 }
 
-Error FBXDocument::_parse_images(Ref<FBXState> p_state, const String &p_base_path) {
-	ERR_FAIL_NULL_V(p_state, ERR_INVALID_PARAMETER);
+struct FBXImageDecodeJob {
+	// Either points into the ufbx content blob, or into `bytes` read from disk.
+	const uint8_t *data = nullptr;
+	int size = 0;
+	Vector<uint8_t> bytes;
+	String path;
+	bool compute_md5 = false;
+	FBXImportCache *cache = nullptr;
+
+	Ref<Image> image;
+	String md5;
+};
+
+static void _decode_image_job(void *p_userdata, uint32_t p_index) {
+	FBXImageDecodeJob &job = static_cast<FBXImageDecodeJob *>(p_userdata)[p_index];
+	if (job.cache) {
+		// Each state gets its own copy, the pixel data itself stays shared until it is written to.
+		const String key = _md5_text(job.data, size_t(job.size));
+		{
+			MutexLock lock(job.cache->mutex);
+			const Ref<Image> *cached = job.cache->decoded_images.getptr(key);
+			if (cached) {
+				job.image.instantiate();
+				job.image->copy_internals_from(*cached);
+			}
+		}
+		if (job.image.is_null()) {
+			job.image = _load_image_from_memory(job.data, job.size, job.path);
+			if (job.image.is_valid()) {
+				Ref<Image> cached;
+				cached.instantiate();
+				cached->copy_internals_from(job.image);
+				MutexLock lock(job.cache->mutex);
+				job.cache->decoded_images[key] = cached;
+			}
+		}
+	} else {
+		job.image = _load_image_from_memory(job.data, job.size, job.path);
+	}
+	if (job.compute_md5 && job.image.is_valid()) {
+		job.md5 = _image_data_md5(job.image->get_data());
+	}
+}
+
+bool FBXDocument::_prepare_image_job(Ref<FBXState> p_state, int p_texture_file, FBXImageDecodeJob &r_job) {
+	const ufbx_texture_file &fbx_texture_file = p_state->scene->texture_files[p_texture_file];
+	String path = _as_string(fbx_texture_file.filename);
+
+	r_job.path = path;
+	r_job.cache = _get_import_cache(p_state).ptr();
+#ifdef TOOLS_ENABLED
+	r_job.compute_md5 = Engine::get_singleton()->is_editor_hint() && FBXState::FBXHandleBinary(p_state->handle_binary_image) == FBXState::FBXHandleBinary::HANDLE_BINARY_EXTRACT_TEXTURES;
+#endif
+	if (fbx_texture_file.content.size > 0 && fbx_texture_file.content.size <= INT_MAX) {
+		r_job.data = static_cast<const uint8_t *>(fbx_texture_file.content.data);
+		r_job.size = int(fbx_texture_file.content.size);
+		return true;
+	}
+
+	// Files that couldn't be loaded as resources before go straight to the byte array fallback.
+	bool try_resource = true;
+	if (r_job.cache) {
+		MutexLock lock(r_job.cache->mutex);
+		const FBXImportCache::ExternalTexture *external = r_job.cache->external_textures.getptr(path);
+		if (external && external->texture.is_valid()) {
+			_store_image(p_state, p_texture_file, external->texture, external->image);
+			return false;
+		}
+		try_resource = !external;
+	}
+	if (try_resource) {
+		Ref<Texture2D> texture = ResourceLoader::load(path);
+		Ref<Image> image = texture.is_valid() ? texture->get_image() : Ref<Image>();
+		if (r_job.cache) {
+			MutexLock lock(r_job.cache->mutex);
+			FBXImportCache::ExternalTexture &external = r_job.cache->external_textures[path];
+			external.texture = texture;
+			external.image = image;
+		}
+		if (texture.is_valid()) {
+			_store_image(p_state, p_texture_file, texture, image);
+			return false;
+		}
+	}
+	// Fallback to loading as byte array. This enables us to support the
+	// spec's requirement that we honor mimetype regardless of file URI.
+	r_job.bytes = FileAccess::get_file_as_bytes(path);
+	if (r_job.bytes.size() == 0) {
+		WARN_PRINT(vformat("FBX: Image index '%d' couldn't be loaded from path: %s because there was no data to load. Skipping it.", p_texture_file, path));
+		return false;
+	}
+	r_job.data = r_job.bytes.ptr();
+	r_job.size = r_job.bytes.size();
+	return true;
+}
 
+void FBXDocument::_finish_image_job(Ref<FBXState> p_state, int p_texture_file, FBXImageDecodeJob &r_job) {
+	Ref<Image> img = r_job.image;
+	// If it can't be loaded, give up and insert an empty image as placeholder.
+	if (img.is_null()) {
+		ERR_PRINT(vformat("FBX: Couldn't load image index '%d'", p_texture_file));
+		img.instantiate();
+	}
+	img->set_name(itos(p_texture_file));
+	// Images are always saved as PNG here, so the source bytes are never needed.
+	_parse_image_save_image(p_state, Vector<uint8_t>(), String(), p_texture_file, img, r_job.md5, p_texture_file);
+	r_job.bytes.clear();
+	r_job.image.unref();
+}
+
+// Decodes the given texture files on worker threads and saves them in order. Embedded payloads
+// are decoded in place and identical ones are only decoded once, the images loaded as resources
+// are kept as-is.
+void FBXDocument::_decode_images(Ref<FBXState> p_state, const LocalVector<int> &p_textures) {
 	const ufbx_scene *fbx_scene = p_state->scene.get();
-	for (int texture_i = 0; texture_i < static_cast<int>(fbx_scene->texture_files.count); texture_i++) {
-		const ufbx_texture_file &fbx_texture_file = fbx_scene->texture_files[texture_i];
-		String path = _as_string(fbx_texture_file.filename);
-
-		Vector<uint8_t> data;
-		if (fbx_texture_file.content.size > 0 && fbx_texture_file.content.size <= INT_MAX) {
-			data.resize(int(fbx_texture_file.content.size));
-			memcpy(data.ptrw(), fbx_texture_file.content.data, fbx_texture_file.content.size);
-		} else {
-			Ref<Texture2D> texture = ResourceLoader::load(path);
-			if (texture.is_valid()) {
-				p_state->images.push_back(texture);
-				p_state->source_images.push_back(texture->get_image());
-				continue;
+	LocalVector<FBXImageDecodeJob> jobs;
+	LocalVector<int> job_textures;
+	LocalVector<int> duplicate_textures;
+	LocalVector<int> duplicate_of;
+	HashMap<uint32_t, LocalVector<int>> embedded_by_hash;
+	for (const int texture_i : p_textures) {
+		const ufbx_blob &content = fbx_scene->texture_files[texture_i].content;
+		if (content.size > 0 && content.size <= INT_MAX) {
+			const uint32_t content_hash = hash_murmur3_buffer(content.data, int(content.size));
+			LocalVector<int> &candidates = embedded_by_hash[content_hash];
+			int original = -1;
+			for (int other_i : candidates) {
+				const ufbx_blob &other = fbx_scene->texture_files[other_i].content;
+				if (other.size == content.size && memcmp(other.data, content.data, content.size) == 0) {
+					original = other_i;
+					break;
+				}
 			}
-			// Fallback to loading as byte array. This enables us to support the
-			// spec's requirement that we honor mimetype regardless of file URI.
-			data = FileAccess::get_file_as_bytes(path);
-			if (data.size() == 0) {
-				WARN_PRINT(vformat("FBX: Image index '%d' couldn't be loaded from path: %s because there was no data to load. Skipping it.", texture_i, path));
-				p_state->images.push_back(Ref<Texture2D>()); // Placeholder to keep count.
-				p_state->source_images.push_back(Ref<Image>());
+			if (original >= 0) {
+				duplicate_textures.push_back(texture_i);
+				duplicate_of.push_back(original);
 				continue;
 			}
+			candidates.push_back(texture_i);
+		}
+
+		FBXImageDecodeJob job;
+		if (_prepare_image_job(p_state, texture_i, job)) {
+			jobs.push_back(job);
+			job_textures.push_back(texture_i);
+		}
+	}
+
+	if (!jobs.is_empty()) {
+		WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_native_group_task(&_decode_image_job, jobs.ptr(), int(jobs.size()), -1, true, SNAME("FBXDecodeImages"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+	}
+
+	// Save the images in texture order, then share the ones with duplicated payloads.
+	for (uint32_t job_i = 0; job_i < jobs.size(); job_i++) {
+		_report_progress(PROGRESS_STAGE_IMAGES, float(job_i) / float(jobs.size()));
+		_finish_image_job(p_state, job_textures[job_i], jobs[job_i]);
+	}
+	for (uint32_t duplicate_i = 0; duplicate_i < duplicate_textures.size(); duplicate_i++) {
+		const int texture_i = duplicate_textures[duplicate_i];
+		p_state->images.write[texture_i] = p_state->images[duplicate_of[duplicate_i]];
+		p_state->source_images.write[texture_i] = p_state->source_images[duplicate_of[duplicate_i]];
+	}
+}
+
+// Decodes the pending images the selected materials refer to in one go, so lazy textures and
+// node filters keep the parallel decode and the sharing of identical payloads.
+void FBXDocument::_decode_material_images(Ref<FBXState> p_state) {
+	if (p_state->pending_images.is_empty()) {
+		return;
+	}
+	const ufbx_scene *fbx_scene = p_state->scene.get();
+	LocalVector<int> textures;
+	for (FBXMaterialIndex material_i = 0; material_i < static_cast<FBXMaterialIndex>(fbx_scene->materials.count); material_i++) {
+		if (!p_state->selected_materials.is_empty() && !p_state->selected_materials[material_i]) {
+			continue;
+		}
+		const ufbx_material *fbx_material = fbx_scene->materials[material_i];
+		const ufbx_material_map *map_lists[] = { fbx_material->fbx.maps, fbx_material->pbr.maps };
+		const int map_counts[] = { UFBX_MATERIAL_FBX_MAP_COUNT, UFBX_MATERIAL_PBR_MAP_COUNT };
+		for (int list_i = 0; list_i < 2; list_i++) {
+			for (int map_i = 0; map_i < map_counts[list_i]; map_i++) {
+				const ufbx_texture *fbx_texture = _get_file_texture(map_lists[list_i][map_i].texture);
+				if (fbx_texture && p_state->pending_images.erase(FBXImageIndex(fbx_texture->file_index))) {
+					textures.push_back(int(fbx_texture->file_index));
+				}
+			}
 		}
+	}
+	textures.sort();
+	_decode_images(p_state, textures);
+}
+
+void FBXDocument::_resolve_image(Ref<FBXState> p_state, FBXImageIndex p_image) {
+	if (!p_state->pending_images.erase(p_image)) {
+		return;
+	}
+	FBXImageDecodeJob job;
+	if (_prepare_image_job(p_state, p_image, job)) {
+		_decode_image_job(&job, 0);
+		_finish_image_job(p_state, p_image, job);
+	}
+}
+
+Error FBXDocument::_parse_images(Ref<FBXState> p_state, const String &p_base_path) {
+	ERR_FAIL_NULL_V(p_state, ERR_INVALID_PARAMETER);
 
-		// Parse the image data from bytes into an Image resource and save if needed.
-		String file_extension;
-		Ref<Image> img = _parse_image_bytes_into_image(p_state, data, path, texture_i);
-		img->set_name(itos(texture_i));
-		_parse_image_save_image(p_state, data, file_extension, texture_i, img);
+	const ufbx_scene *fbx_scene = p_state->scene.get();
+	const int texture_count = static_cast<int>(fbx_scene->texture_files.count);
+
+	// Every texture file gets an image slot, left empty if it can't be loaded.
+	p_state->images.resize(texture_count);
+	p_state->source_images.resize(texture_count);
+
+	if (p_state->lazy_textures || !p_state->selected_materials.is_empty()) {
+		// Nothing is decoded until the materials are parsed, see `_decode_material_images()`.
+		// With a node filter this skips the textures of the materials that aren't selected.
+		// Images no material refers to keep a null slot in `images` for good.
+		for (int texture_i = 0; texture_i < texture_count; texture_i++) {
+			p_state->pending_images.insert(texture_i);
+		}
+	} else {
+		LocalVector<int> textures;
+		textures.resize(texture_count);
+		for (int texture_i = 0; texture_i < texture_count; texture_i++) {
+			textures[texture_i] = texture_i;
+		}
+		_decode_images(p_state, textures);
 	}
 
 	// Create a texture for each file texture.
@@ -1061,8 +2101,10 @@ Ref<Texture2D> FBXDocument::_get_texture(Ref<FBXState> p_state, const FBXTexture
 	ERR_FAIL_INDEX_V(p_texture, p_state->textures.size(), Ref<Texture2D>());
 	const FBXImageIndex image = p_state->textures[p_texture]->get_src_image();
 	ERR_FAIL_INDEX_V(image, p_state->images.size(), Ref<Texture2D>());
+	_resolve_image(p_state, image);
 	if (FBXState::FBXHandleBinary(p_state->handle_binary_image) == FBXState::FBXHandleBinary::HANDLE_BINARY_EMBED_AS_BASISU) {
 		ERR_FAIL_INDEX_V(image, p_state->source_images.size(), Ref<Texture2D>());
+		ERR_FAIL_COND_V(p_state->source_images[image].is_null(), Ref<Texture2D>());
 		Ref<PortableCompressedTexture2D> portable_texture;
 		portable_texture.instantiate();
 		portable_texture->set_keep_compressed_buffer(true);
@@ -1082,6 +2124,7 @@ Ref<Texture2D> FBXDocument::_get_texture(Ref<FBXState> p_state, const FBXTexture
 
 Error FBXDocument::_parse_materials(Ref<FBXState> p_state) {
 	const ufbx_scene *fbx_scene = p_state->scene.get();
+	_decode_material_images(p_state);
 	for (FBXMaterialIndex material_i = 0; material_i < static_cast<FBXMaterialIndex>(fbx_scene->materials.count); material_i++) {
 		const ufbx_material *fbx_material = fbx_scene->materials[material_i];
 
@@ -1093,6 +2136,11 @@ Error FBXDocument::_parse_materials(Ref<FBXState> p_state) {
 			material->set_name(vformat("material_%s", itos(material_i)));
 		}
 		material->set_flag(BaseMaterial3D::FLAG_ALBEDO_FROM_VERTEX_COLOR, true);
+		if (!p_state->selected_materials.is_empty() && !p_state->selected_materials[material_i]) {
+			// Only used by meshes outside of the node filter, keep the slot so indices don't change.
+			p_state->materials.push_back(material);
+			continue;
+		}
 		Dictionary material_extensions;
 
 		if (fbx_material->pbr.base_color.has_value) {
@@ -1140,19 +2188,24 @@ Error FBXDocument::_parse_materials(Ref<FBXState> p_state) {
 					Ref<Image> transparency_image = _get_decompressed_image(transparency_texture);
 
 					if (albedo_image.is_valid() && transparency_image.is_valid()) {
+						// Only the first mipmap level is combined, the rest is regenerated below.
+						albedo_image->clear_mipmaps();
 						albedo_image->convert(Image::Format::FORMAT_RGBA8);
-						transparency_image->resize(albedo_texture->get_width(), albedo_texture->get_height(), Image::INTERPOLATE_LANCZOS);
-						for (int y = 0; y < albedo_image->get_height(); y++) {
-							for (int x = 0; x < albedo_image->get_width(); x++) {
-								Color albedo_pixel = albedo_image->get_pixel(x, y);
-								Color transparency_pixel = transparency_image->get_pixel(x, y);
-								albedo_pixel.a *= transparency_pixel.r;
-								albedo_image->set_pixel(x, y, albedo_pixel);
-							}
+						transparency_image->clear_mipmaps();
+						transparency_image->resize(albedo_image->get_width(), albedo_image->get_height(), Image::INTERPOLATE_LANCZOS);
+						if (transparency_image->get_format() != Image::FORMAT_L8) {
+							transparency_image->convert(Image::FORMAT_R8);
 						}
+						Image::AlphaMode combined_alpha_mode = _multiply_image_alpha(albedo_image, transparency_image);
 
-						albedo_image->clear_mipmaps();
 						albedo_image->generate_mipmaps();
+						if (combined_alpha_mode == Image::ALPHA_BIT && albedo_image->get_mipmap_count() > 0) {
+							// Averaging a cutout into smaller mipmaps can produce partial alpha.
+							const int64_t mipmap_offset = albedo_image->get_mipmap_offset(1);
+							const Vector<uint8_t> data = albedo_image->get_data();
+							combined_alpha_mode = _detect_rgba8_alpha(data.ptr() + mipmap_offset, (data.size() - mipmap_offset) / 4);
+							combined_alpha_mode = combined_alpha_mode == Image::ALPHA_BLEND ? Image::ALPHA_BLEND : Image::ALPHA_BIT;
+						}
 
 						albedo_image->set_name(vformat("alpha_%d", p_state->albedo_transparency_textures.size()));
 
@@ -1167,6 +2220,9 @@ Error FBXDocument::_parse_materials(Ref<FBXState> p_state) {
 							p_state->albedo_transparency_textures[key] = texture_index;
 
 							albedo_texture = _get_texture(p_state, texture_index, TEXTURE_TYPE_GENERIC);
+							if (albedo_texture.is_valid()) {
+								p_state->alpha_mode_cache[albedo_texture->get_rid().get_id()] = combined_alpha_mode;
+							}
 						} else {
 							WARN_PRINT(vformat("FBX: Could not save modified albedo texture from RID (%d, %d).", key.first, key.second));
 							p_state->albedo_transparency_textures[key] = -1;
@@ -1181,8 +2237,7 @@ Error FBXDocument::_parse_materials(Ref<FBXState> p_state) {
 				if (alpha_mode_ptr != nullptr) {
 					alpha_mode = *alpha_mode_ptr;
 				} else {
-					Ref<Image> albedo_image = _get_decompressed_image(albedo_texture);
-					alpha_mode = albedo_image->detect_alpha();
+					alpha_mode = _detect_texture_alpha(albedo_texture);
 					p_state->alpha_mode_cache[albedo_texture->get_rid().get_id()] = alpha_mode;
 				}
 
@@ -1275,12 +2330,12 @@ FBXNodeIndex FBXDocument::_find_highest_node(Ref<FBXState> p_state, const Vector
 	int highest = -1;
 	FBXNodeIndex best_node = -1;
 
+	const LocalVector<int> &heights = p_state->node_table.heights;
 	for (int i = 0; i < p_subset.size(); ++i) {
 		const FBXNodeIndex node_i = p_subset[i];
-		const Ref<FBXNode> node = p_state->nodes[node_i];
 
-		if (highest == -1 || node->height < highest) {
-			highest = node->height;
+		if (highest == -1 || heights[node_i] < highest) {
+			highest = heights[node_i];
 			best_node = node_i;
 		}
 	}
@@ -1291,13 +2346,13 @@ FBXNodeIndex FBXDocument::_find_highest_node(Ref<FBXState> p_state, const Vector
 bool FBXDocument::_capture_nodes_in_skin(Ref<FBXState> p_state, Ref<FBXSkin> p_skin, const FBXNodeIndex p_node_index) {
 	bool found_joint = false;
 
-	for (int i = 0; i < p_state->nodes[p_node_index]->children.size(); ++i) {
-		found_joint |= _capture_nodes_in_skin(p_state, p_skin, p_state->nodes[p_node_index]->children[i]);
+	for (const FBXNodeIndex child_i : p_state->node_table.get_children(p_node_index)) {
+		found_joint |= _capture_nodes_in_skin(p_state, p_skin, child_i);
 	}
 
 	if (found_joint) {
 		// Mark it if we happen to find another skins joint...
-		if (p_state->nodes[p_node_index]->joint && p_skin->joints.find(p_node_index) < 0) {
+		if (p_state->node_table.joints[p_node_index] && p_skin->joints.find(p_node_index) < 0) {
 			p_skin->joints.push_back(p_node_index);
 		} else if (p_skin->non_joints.find(p_node_index) < 0) {
 			p_skin->non_joints.push_back(p_node_index);
@@ -1316,7 +2371,7 @@ void FBXDocument::_capture_nodes_for_multirooted_skin(Ref<FBXState> p_state, Ref
 
 	for (int i = 0; i < p_skin->joints.size(); ++i) {
 		const FBXNodeIndex node_index = p_skin->joints[i];
-		const FBXNodeIndex parent = p_state->nodes[node_index]->parent;
+		const FBXNodeIndex parent = p_state->node_table.parents[node_index];
 		disjoint_set.insert(node_index);
 
 		if (p_skin->joints.find(parent) >= 0) {
@@ -1337,8 +2392,8 @@ void FBXDocument::_capture_nodes_for_multirooted_skin(Ref<FBXState> p_state, Ref
 	for (int i = 0; i < roots.size(); ++i) {
 		const FBXNodeIndex root = roots[i];
 
-		if (maxHeight == -1 || p_state->nodes[root]->height < maxHeight) {
-			maxHeight = p_state->nodes[root]->height;
+		if (maxHeight == -1 || p_state->node_table.heights[root] < maxHeight) {
+			maxHeight = p_state->node_table.heights[root];
 		}
 	}
 
@@ -1346,10 +2401,10 @@ void FBXDocument::_capture_nodes_for_multirooted_skin(Ref<FBXState> p_state, Ref
 	// This sucks, but 99% of all game engines (not just Godot) would have this same issue.
 	for (int i = 0; i < roots.size(); ++i) {
 		FBXNodeIndex current_node = roots[i];
-		while (p_state->nodes[current_node]->height > maxHeight) {
-			FBXNodeIndex parent = p_state->nodes[current_node]->parent;
+		while (p_state->node_table.heights[current_node] > maxHeight) {
+			FBXNodeIndex parent = p_state->node_table.parents[current_node];
 
-			if (p_state->nodes[parent]->joint && p_skin->joints.find(parent) < 0) {
+			if (p_state->node_table.joints[parent] && p_skin->joints.find(parent) < 0) {
 				p_skin->joints.push_back(parent);
 			} else if (p_skin->non_joints.find(parent) < 0) {
 				p_skin->non_joints.push_back(parent);
@@ -1367,18 +2422,18 @@ void FBXDocument::_capture_nodes_for_multirooted_skin(Ref<FBXState> p_state, Ref
 
 	do {
 		all_same = true;
-		const FBXNodeIndex first_parent = p_state->nodes[roots[0]]->parent;
+		const FBXNodeIndex first_parent = p_state->node_table.parents[roots[0]];
 
 		for (int i = 1; i < roots.size(); ++i) {
-			all_same &= (first_parent == p_state->nodes[roots[i]]->parent);
+			all_same &= (first_parent == p_state->node_table.parents[roots[i]]);
 		}
 
 		if (!all_same) {
 			for (int i = 0; i < roots.size(); ++i) {
 				const FBXNodeIndex current_node = roots[i];
-				const FBXNodeIndex parent = p_state->nodes[current_node]->parent;
+				const FBXNodeIndex parent = p_state->node_table.parents[current_node];
 
-				if (p_state->nodes[parent]->joint && p_skin->joints.find(parent) < 0) {
+				if (p_state->node_table.joints[parent] && p_skin->joints.find(parent) < 0) {
 					p_skin->joints.push_back(parent);
 				} else if (p_skin->non_joints.find(parent) < 0) {
 					p_skin->non_joints.push_back(parent);
@@ -1403,7 +2458,7 @@ Error FBXDocument::_expand_skin(Ref<FBXState> p_state, Ref<FBXSkin> p_skin) {
 
 	for (int i = 0; i < all_skin_nodes.size(); ++i) {
 		const FBXNodeIndex node_index = all_skin_nodes[i];
-		const FBXNodeIndex parent = p_state->nodes[node_index]->parent;
+		const FBXNodeIndex parent = p_state->node_table.parents[node_index];
 		disjoint_set.insert(node_index);
 
 		if (all_skin_nodes.find(parent) >= 0) {
@@ -1453,7 +2508,7 @@ Error FBXDocument::_verify_skin(Ref<FBXState> p_state, Ref<FBXSkin> p_skin) {
 
 	for (int i = 0; i < all_skin_nodes.size(); ++i) {
 		const FBXNodeIndex node_index = all_skin_nodes[i];
-		const FBXNodeIndex parent = p_state->nodes[node_index]->parent;
+		const FBXNodeIndex parent = p_state->node_table.parents[node_index];
 		disjoint_set.insert(node_index);
 
 		if (all_skin_nodes.find(parent) >= 0) {
@@ -1491,9 +2546,9 @@ Error FBXDocument::_verify_skin(Ref<FBXState> p_state, Ref<FBXSkin> p_skin) {
 	}
 
 	// Make sure all parents of a multi-rooted skin are the SAME
-	const FBXNodeIndex parent = p_state->nodes[out_roots[0]]->parent;
+	const FBXNodeIndex parent = p_state->node_table.parents[out_roots[0]];
 	for (int i = 1; i < out_roots.size(); ++i) {
-		if (p_state->nodes[out_roots[i]]->parent != parent) {
+		if (p_state->node_table.parents[out_roots[i]] != parent) {
 			return FAILED;
 		}
 	}
@@ -1522,7 +2577,7 @@ Error FBXDocument::_parse_skins(Ref<FBXState> p_state) {
 
 			skin->joints.push_back(node);
 			skin->joints_original.push_back(node);
-			p_state->nodes.write[node]->joint = true;
+			p_state->node_table.joints[node] = true;
 		}
 
 		if (fbx_skin->name.length > 0) {
@@ -1539,8 +2594,8 @@ Error FBXDocument::_parse_skins(Ref<FBXState> p_state) {
 	for (const ufbx_bone *fbx_bone : fbx_scene->bones) {
 		for (const ufbx_node *fbx_node : fbx_bone->instances) {
 			const FBXNodeIndex node = fbx_node->typed_id;
-			if (!p_state->nodes.write[node]->joint) {
-				p_state->nodes.write[node]->joint = true;
+			if (!p_state->node_table.joints[node]) {
+				p_state->node_table.joints[node] = true;
 
 				// Mark root bones as virtual skins, we only need to mark the root node
 				// as `_expand_skin()` below will capture child bones.
@@ -1571,45 +2626,140 @@ Error FBXDocument::_parse_skins(Ref<FBXState> p_state) {
 }
 
 void FBXDocument::_recurse_children(Ref<FBXState> p_state, const FBXNodeIndex p_node_index,
-		RBSet<FBXNodeIndex> &p_all_skin_nodes, HashSet<FBXNodeIndex> &p_child_visited_set) {
-	if (p_child_visited_set.has(p_node_index)) {
+		LocalVector<FBXNodeIndex> &r_all_skin_nodes, LocalVector<int> &r_skin_node_stamps, LocalVector<int> &r_child_visited_stamps, int p_stamp) {
+	if (r_child_visited_stamps[p_node_index] == p_stamp) {
 		return;
 	}
-	p_child_visited_set.insert(p_node_index);
-	for (int i = 0; i < p_state->nodes[p_node_index]->children.size(); ++i) {
-		_recurse_children(p_state, p_state->nodes[p_node_index]->children[i], p_all_skin_nodes, p_child_visited_set);
+	r_child_visited_stamps[p_node_index] = p_stamp;
+	const FBXNodeTable &table = p_state->node_table;
+	const FBXNodeTable::Range children = table.get_children(p_node_index);
+	for (const FBXNodeIndex child_i : children) {
+		_recurse_children(p_state, child_i, r_all_skin_nodes, r_skin_node_stamps, r_child_visited_stamps, p_stamp);
+	}
+
+	if (table.skins[p_node_index] < 0 || table.meshes[p_node_index] < 0 || !children.is_empty()) {
+		if (r_skin_node_stamps[p_node_index] != p_stamp) {
+			r_skin_node_stamps[p_node_index] = p_stamp;
+			r_all_skin_nodes.push_back(p_node_index);
+		}
+	}
+}
+
+// Disjoint set over dense node indices. It merges and orders sets exactly like `DisjointSet`
+// (insertion order, union by rank), but can find the root of any node and split every set
+// into its members in a single pass.
+class FBXNodeDisjointSet {
+	LocalVector<FBXNodeIndex> parents;
+	LocalVector<int> ranks;
+	LocalVector<FBXNodeIndex> order;
+
+public:
+	void insert(FBXNodeIndex p_node) {
+		if (parents[p_node] < 0) {
+			parents[p_node] = p_node;
+			order.push_back(p_node);
+		}
+	}
+
+	FBXNodeIndex find(FBXNodeIndex p_node) {
+		while (parents[p_node] != p_node) {
+			parents[p_node] = parents[parents[p_node]];
+			p_node = parents[p_node];
+		}
+		return p_node;
+	}
+
+	void create_union(FBXNodeIndex p_a, FBXNodeIndex p_b) {
+		insert(p_a);
+		insert(p_b);
+		FBXNodeIndex a_root = find(p_a);
+		FBXNodeIndex b_root = find(p_b);
+		if (a_root == b_root) {
+			return;
+		}
+		if (ranks[a_root] < ranks[b_root]) {
+			SWAP(a_root, b_root);
+		}
+		parents[b_root] = a_root;
+		if (ranks[a_root] == ranks[b_root]) {
+			ranks[a_root]++;
+		}
+	}
+
+	// Representatives and members are both in insertion order, like `DisjointSet::get_representatives()` and `DisjointSet::get_members()`.
+	void get_groups(Vector<FBXNodeIndex> &r_representatives, Vector<Vector<FBXNodeIndex>> &r_groups) {
+		LocalVector<int> root_groups;
+		root_groups.resize(parents.size());
+		for (const FBXNodeIndex node : order) {
+			if (parents[node] == node) {
+				root_groups[node] = r_representatives.size();
+				r_representatives.push_back(node);
+			}
+		}
+		r_groups.resize(r_representatives.size());
+		Vector<FBXNodeIndex> *groups = r_groups.ptrw();
+		for (const FBXNodeIndex node : order) {
+			groups[root_groups[find(node)]].push_back(node);
+		}
 	}
 
-	if (p_state->nodes[p_node_index]->skin < 0 || p_state->nodes[p_node_index]->mesh < 0 || !p_state->nodes[p_node_index]->children.is_empty()) {
-		p_all_skin_nodes.insert(p_node_index);
+	FBXNodeDisjointSet(int p_node_count) {
+		parents.resize(p_node_count);
+		ranks.resize(p_node_count);
+		for (int i = 0; i < p_node_count; i++) {
+			parents[i] = -1;
+			ranks[i] = 0;
+		}
 	}
-}
+};
 
 Error FBXDocument::_determine_skeletons(Ref<FBXState> p_state) {
 	// Using a disjoint set, we are going to potentially combine all skins that are actually branches
 	// of a main skeleton, or treat skins defining the same set of nodes as ONE skeleton.
 	// This is another unclear issue caused by the current glTF specification.
 
-	DisjointSet<FBXNodeIndex> skeleton_sets;
+	const int node_count = p_state->node_table.size();
+	FBXNodeDisjointSet skeleton_sets(node_count);
+
+	// Per-skin node sets are stamped with the skin index, so nothing is cleared between skins.
+	LocalVector<int> skin_node_stamps;
+	LocalVector<int> child_visited_stamps;
+	skin_node_stamps.resize(node_count);
+	child_visited_stamps.resize(node_count);
+	for (int i = 0; i < node_count; i++) {
+		skin_node_stamps[i] = -1;
+		child_visited_stamps[i] = -1;
+	}
+	LocalVector<FBXNodeIndex> all_skin_nodes;
 
 	for (FBXSkinIndex skin_i = 0; skin_i < p_state->skins.size(); ++skin_i) {
 		const Ref<FBXSkin> skin = p_state->skins[skin_i];
 
-		HashSet<FBXNodeIndex> child_visited_set;
-		RBSet<FBXNodeIndex> all_skin_nodes;
+		all_skin_nodes.clear();
 		for (int i = 0; i < skin->joints.size(); ++i) {
-			all_skin_nodes.insert(skin->joints[i]);
-			_recurse_children(p_state, skin->joints[i], all_skin_nodes, child_visited_set);
+			const FBXNodeIndex node_index = skin->joints[i];
+			if (skin_node_stamps[node_index] != skin_i) {
+				skin_node_stamps[node_index] = skin_i;
+				all_skin_nodes.push_back(node_index);
+			}
+			_recurse_children(p_state, node_index, all_skin_nodes, skin_node_stamps, child_visited_stamps, skin_i);
 		}
 		for (int i = 0; i < skin->non_joints.size(); ++i) {
-			all_skin_nodes.insert(skin->non_joints[i]);
-			_recurse_children(p_state, skin->non_joints[i], all_skin_nodes, child_visited_set);
+			const FBXNodeIndex node_index = skin->non_joints[i];
+			if (skin_node_stamps[node_index] != skin_i) {
+				skin_node_stamps[node_index] = skin_i;
+				all_skin_nodes.push_back(node_index);
+			}
+			_recurse_children(p_state, node_index, all_skin_nodes, skin_node_stamps, child_visited_stamps, skin_i);
 		}
-		for (FBXNodeIndex node_index : all_skin_nodes) {
-			const FBXNodeIndex parent = p_state->nodes[node_index]->parent;
+
+		// Same union order as iterating the sorted set of skin nodes.
+		all_skin_nodes.sort();
+		for (const FBXNodeIndex node_index : all_skin_nodes) {
+			const FBXNodeIndex parent = p_state->node_table.parents[node_index];
 			skeleton_sets.insert(node_index);
 
-			if (all_skin_nodes.has(parent)) {
+			if (parent >= 0 && skin_node_stamps[parent] == skin_i) {
 				skeleton_sets.create_union(parent, node_index);
 			}
 		}
@@ -1623,40 +2773,47 @@ Error FBXDocument::_determine_skeletons(Ref<FBXState> p_state) {
 
 	{ // attempt to joint all touching subsets (siblings/parent are part of another skin)
 		Vector<FBXNodeIndex> groups_representatives;
-		skeleton_sets.get_representatives(groups_representatives);
+		Vector<Vector<FBXNodeIndex>> groups;
+		skeleton_sets.get_groups(groups_representatives, groups);
+
+		LocalVector<int> node_groups;
+		node_groups.resize(node_count);
+		for (int i = 0; i < node_count; i++) {
+			node_groups[i] = -1;
+		}
 
+		// Groups are bucketed by the parent of their highest node, in group order.
 		Vector<FBXNodeIndex> highest_group_members;
-		Vector<Vector<FBXNodeIndex>> groups;
-		for (int i = 0; i < groups_representatives.size(); ++i) {
-			Vector<FBXNodeIndex> group;
-			skeleton_sets.get_members(group, groups_representatives[i]);
-			highest_group_members.push_back(_find_highest_node(p_state, group));
-			groups.push_back(group);
+		HashMap<FBXNodeIndex, LocalVector<int>> groups_by_parent;
+		for (int i = 0; i < groups.size(); ++i) {
+			const FBXNodeIndex highest = _find_highest_node(p_state, groups[i]);
+			highest_group_members.push_back(highest);
+			groups_by_parent[p_state->node_table.parents[highest]].push_back(i);
+			for (const FBXNodeIndex node_i : groups[i]) {
+				node_groups[node_i] = i;
+			}
 		}
 
 		for (int i = 0; i < highest_group_members.size(); ++i) {
 			const FBXNodeIndex node_i = highest_group_members[i];
-
-			// Attach any siblings together (this needs to be done n^2/2 times)
-			for (int j = i + 1; j < highest_group_members.size(); ++j) {
-				const FBXNodeIndex node_j = highest_group_members[j];
-
-				// Even if they are siblings under the root! :)
-				if (p_state->nodes[node_i]->parent == p_state->nodes[node_j]->parent) {
-					skeleton_sets.create_union(node_i, node_j);
+			const FBXNodeIndex node_i_parent = p_state->node_table.parents[node_i];
+
+			// Attach any siblings together, even if they are siblings under the root! :)
+			// The first group of each bucket joins all the others, afterwards they already share a set.
+			const LocalVector<int> &siblings = groups_by_parent[node_i_parent];
+			if (siblings[0] == i) {
+				for (uint32_t j = 1; j < siblings.size(); ++j) {
+					skeleton_sets.create_union(node_i, highest_group_members[siblings[j]]);
 				}
 			}
 
-			// Attach any parenting going on together (we need to do this n^2 times)
-			const FBXNodeIndex node_i_parent = p_state->nodes[node_i]->parent;
+			// Attach any parenting going on together. Only groups before this one are
+			// considered, which is what the previous pairwise loop did.
 			if (node_i_parent >= 0) {
-				for (int j = 0; j < groups.size() && i != j; ++j) {
-					const Vector<FBXNodeIndex> &group = groups[j];
-
-					if (group.find(node_i_parent) >= 0) {
-						const FBXNodeIndex node_j = highest_group_members[j];
-						skeleton_sets.create_union(node_i, node_j);
-					}
+				const int j = node_groups[node_i_parent];
+				if (j >= 0 && j < i) {
+					const FBXNodeIndex node_j = highest_group_members[j];
+					skeleton_sets.create_union(node_i, node_j);
 				}
 			}
 		}
@@ -1664,35 +2821,28 @@ Error FBXDocument::_determine_skeletons(Ref<FBXState> p_state) {
 
 	// At this point, the skeleton groups should be finalized
 	Vector<FBXNodeIndex> skeleton_owners;
-	skeleton_sets.get_representatives(skeleton_owners);
+	Vector<Vector<FBXNodeIndex>> skeleton_groups;
+	skeleton_sets.get_groups(skeleton_owners, skeleton_groups);
+
+	LocalVector<FBXSkeletonIndex> node_skeletons;
+	node_skeletons.resize(node_count);
+	for (int i = 0; i < node_count; i++) {
+		node_skeletons[i] = -1;
+	}
 
 	// Mark all the skins actual skeletons, after we have merged them
 	for (FBXSkeletonIndex skel_i = 0; skel_i < skeleton_owners.size(); ++skel_i) {
-		const FBXNodeIndex skeleton_owner = skeleton_owners[skel_i];
 		Ref<FBXSkeleton> skeleton;
 		skeleton.instantiate();
 
-		Vector<FBXNodeIndex> skeleton_nodes;
-		skeleton_sets.get_members(skeleton_nodes, skeleton_owner);
-
-		for (FBXSkinIndex skin_i = 0; skin_i < p_state->skins.size(); ++skin_i) {
-			Ref<FBXSkin> skin = p_state->skins.write[skin_i];
-
-			// If any of the the skeletons nodes exist in a skin, that skin now maps to the skeleton
-			for (int i = 0; i < skeleton_nodes.size(); ++i) {
-				FBXNodeIndex skel_node_i = skeleton_nodes[i];
-				if (skin->joints.find(skel_node_i) >= 0 || skin->non_joints.find(skel_node_i) >= 0) {
-					skin->skeleton = skel_i;
-					continue;
-				}
-			}
-		}
+		const Vector<FBXNodeIndex> &skeleton_nodes = skeleton_groups[skel_i];
 
 		Vector<FBXNodeIndex> non_joints;
 		for (int i = 0; i < skeleton_nodes.size(); ++i) {
 			const FBXNodeIndex node_i = skeleton_nodes[i];
+			node_skeletons[node_i] = skel_i;
 
-			if (p_state->nodes[node_i]->joint) {
+			if (p_state->node_table.joints[node_i]) {
 				skeleton->joints.push_back(node_i);
 			} else {
 				non_joints.push_back(node_i);
@@ -1704,16 +2854,31 @@ Error FBXDocument::_determine_skeletons(Ref<FBXState> p_state) {
 		_reparent_non_joint_skeleton_subtrees(p_state, p_state->skeletons.write[skel_i], non_joints);
 	}
 
+	// If any of the the skeletons nodes exist in a skin, that skin now maps to the skeleton.
+	// The last matching skeleton wins.
+	for (FBXSkinIndex skin_i = 0; skin_i < p_state->skins.size(); ++skin_i) {
+		Ref<FBXSkin> skin = p_state->skins.write[skin_i];
+		FBXSkeletonIndex skin_skeleton = -1;
+		for (const FBXNodeIndex node_i : skin->joints) {
+			skin_skeleton = MAX(skin_skeleton, node_skeletons[node_i]);
+		}
+		for (const FBXNodeIndex node_i : skin->non_joints) {
+			skin_skeleton = MAX(skin_skeleton, node_skeletons[node_i]);
+		}
+		if (skin_skeleton >= 0) {
+			skin->skeleton = skin_skeleton;
+		}
+	}
+
 	for (FBXSkeletonIndex skel_i = 0; skel_i < p_state->skeletons.size(); ++skel_i) {
 		Ref<FBXSkeleton> skeleton = p_state->skeletons.write[skel_i];
 
 		for (int i = 0; i < skeleton->joints.size(); ++i) {
 			const FBXNodeIndex node_i = skeleton->joints[i];
-			Ref<FBXNode> node = p_state->nodes[node_i];
 
-			ERR_FAIL_COND_V(!node->joint, ERR_PARSE_ERROR);
-			ERR_FAIL_COND_V(node->skeleton >= 0, ERR_PARSE_ERROR);
-			node->skeleton = skel_i;
+			ERR_FAIL_COND_V(!p_state->node_table.joints[node_i], ERR_PARSE_ERROR);
+			ERR_FAIL_COND_V(p_state->node_table.skeletons[node_i] >= 0, ERR_PARSE_ERROR);
+			p_state->node_table.skeletons[node_i] = skel_i;
 		}
 
 		ERR_FAIL_COND_V(_determine_skeleton_roots(p_state, skel_i), ERR_PARSE_ERROR);
@@ -1738,8 +2903,8 @@ Error FBXDocument::_reparent_non_joint_skeleton_subtrees(Ref<FBXState> p_state,
 
 		subtree_set.insert(node_i);
 
-		const FBXNodeIndex parent_i = p_state->nodes[node_i]->parent;
-		if (parent_i >= 0 && p_non_joints.find(parent_i) >= 0 && !p_state->nodes[parent_i]->joint) {
+		const FBXNodeIndex parent_i = p_state->node_table.parents[node_i];
+		if (parent_i >= 0 && p_non_joints.find(parent_i) >= 0 && !p_state->node_table.joints[parent_i]) {
 			subtree_set.create_union(parent_i, node_i);
 		}
 	}
@@ -1756,8 +2921,7 @@ Error FBXDocument::_reparent_non_joint_skeleton_subtrees(Ref<FBXState> p_state,
 		subtree_set.get_members(subtree_nodes, subtree_root);
 
 		for (int subtree_i = 0; subtree_i < subtree_nodes.size(); ++subtree_i) {
-			Ref<FBXNode> node = p_state->nodes[subtree_nodes[subtree_i]];
-			node->joint = true;
+			p_state->node_table.joints[subtree_nodes[subtree_i]] = true;
 			// Add the joint to the skeletons joints
 			p_skeleton->joints.push_back(subtree_nodes[subtree_i]);
 		}
@@ -1769,22 +2933,21 @@ Error FBXDocument::_reparent_non_joint_skeleton_subtrees(Ref<FBXState> p_state,
 Error FBXDocument::_determine_skeleton_roots(Ref<FBXState> p_state, const FBXSkeletonIndex p_skel_i) {
 	DisjointSet<FBXNodeIndex> disjoint_set;
 
-	for (FBXNodeIndex i = 0; i < p_state->nodes.size(); ++i) {
-		const Ref<FBXNode> node = p_state->nodes[i];
+	Ref<FBXSkeleton> skeleton = p_state->skeletons.write[p_skel_i];
 
-		if (node->skeleton != p_skel_i) {
-			continue;
-		}
+	// The nodes of this skeleton are exactly its joints, visit them in node order.
+	Vector<FBXNodeIndex> skeleton_nodes = skeleton->joints;
+	skeleton_nodes.sort();
+	for (const FBXNodeIndex i : skeleton_nodes) {
+		const FBXNodeIndex parent = p_state->node_table.parents[i];
 
 		disjoint_set.insert(i);
 
-		if (node->parent >= 0 && p_state->nodes[node->parent]->skeleton == p_skel_i) {
-			disjoint_set.create_union(node->parent, i);
+		if (parent >= 0 && p_state->node_table.skeletons[parent] == p_skel_i) {
+			disjoint_set.create_union(parent, i);
 		}
 	}
 
-	Ref<FBXSkeleton> skeleton = p_state->skeletons.write[p_skel_i];
-
 	Vector<FBXNodeIndex> representatives;
 	disjoint_set.get_representatives(representatives);
 
@@ -1809,9 +2972,9 @@ Error FBXDocument::_determine_skeleton_roots(Ref<FBXState> p_state, const FBXSke
 	}
 
 	// Check that the subtrees have the same parent root
-	const FBXNodeIndex parent = p_state->nodes[roots[0]]->parent;
+	const FBXNodeIndex parent = p_state->node_table.parents[roots[0]];
 	for (int i = 1; i < roots.size(); ++i) {
-		if (p_state->nodes[roots[i]]->parent != parent) {
+		if (p_state->node_table.parents[roots[i]] != parent) {
 			return FAILED;
 		}
 	}
@@ -1844,14 +3007,13 @@ Error FBXDocument::_create_skeletons(Ref<FBXState> p_state) {
 			const FBXNodeIndex node_i = bones.front()->get();
 			bones.pop_front();
 
-			Ref<FBXNode> node = p_state->nodes[node_i];
-			ERR_FAIL_COND_V(node->skeleton != skel_i, FAILED);
+			FBXNodeTable &table = p_state->node_table;
+			ERR_FAIL_COND_V(table.skeletons[node_i] != skel_i, FAILED);
 
 			{ // Add all child nodes to the stack (deterministically)
 				Vector<FBXNodeIndex> child_nodes;
-				for (int i = 0; i < node->children.size(); ++i) {
-					const FBXNodeIndex child_i = node->children[i];
-					if (p_state->nodes[child_i]->skeleton == skel_i) {
+				for (const FBXNodeIndex child_i : table.get_children(node_i)) {
+					if (table.skeletons[child_i] == skel_i) {
 						child_nodes.push_back(child_i);
 					}
 				}
@@ -1865,22 +3027,23 @@ Error FBXDocument::_create_skeletons(Ref<FBXState> p_state) {
 
 			const int bone_index = skeleton->get_bone_count();
 
-			if (node->get_name().is_empty()) {
-				node->set_name("bone");
+			if (table.names[node_i].is_empty()) {
+				table.names[node_i] = "bone";
 			}
 
-			node->set_name(_gen_unique_bone_name(p_state, skel_i, node->get_name()));
+			table.names[node_i] = _gen_unique_bone_name(p_state, skel_i, table.names[node_i]);
 
-			skeleton->add_bone(node->get_name());
-			skeleton->set_bone_rest(bone_index, node->xform);
-			skeleton->set_bone_pose_position(bone_index, node->position);
-			skeleton->set_bone_pose_rotation(bone_index, node->rotation.normalized());
-			skeleton->set_bone_pose_scale(bone_index, node->scale);
+			skeleton->add_bone(table.names[node_i]);
+			skeleton->set_bone_rest(bone_index, table.xforms[node_i]);
+			skeleton->set_bone_pose_position(bone_index, table.positions[node_i]);
+			skeleton->set_bone_pose_rotation(bone_index, table.rotations[node_i].normalized());
+			skeleton->set_bone_pose_scale(bone_index, table.scales[node_i]);
 
-			if (node->parent >= 0 && p_state->nodes[node->parent]->skeleton == skel_i) {
-				const int bone_parent = skeleton->find_bone(p_state->nodes[node->parent]->get_name());
+			const FBXNodeIndex parent = table.parents[node_i];
+			if (parent >= 0 && table.skeletons[parent] == skel_i) {
+				const int bone_parent = skeleton->find_bone(table.names[parent]);
 				ERR_FAIL_COND_V(bone_parent < 0, FAILED);
-				skeleton->set_bone_parent(bone_index, skeleton->find_bone(p_state->nodes[node->parent]->get_name()));
+				skeleton->set_bone_parent(bone_index, skeleton->find_bone(table.names[parent]));
 			}
 
 			p_state->scene_nodes.insert(node_i, skeleton);
@@ -1900,9 +3063,8 @@ Error FBXDocument::_map_skin_joints_indices_to_skeleton_bone_indices(Ref<FBXStat
 
 		for (int joint_index = 0; joint_index < skin->joints_original.size(); ++joint_index) {
 			const FBXNodeIndex node_i = skin->joints_original[joint_index];
-			const Ref<FBXNode> node = p_state->nodes[node_i];
 
-			const int bone_index = skeleton->godot_skeleton->find_bone(node->get_name());
+			const int bone_index = skeleton->godot_skeleton->find_bone(p_state->node_table.names[node_i]);
 			ERR_FAIL_COND_V(bone_index < 0, FAILED);
 
 			skin->joint_i_to_bone_i.insert(joint_index, bone_index);
@@ -1924,7 +3086,7 @@ Error FBXDocument::_create_skins(Ref<FBXState> p_state) {
 
 		for (int joint_i = 0; joint_i < gltf_skin->joints_original.size(); ++joint_i) {
 			FBXNodeIndex node = gltf_skin->joints_original[joint_i];
-			String bone_name = p_state->nodes[node]->get_name();
+			String bone_name = p_state->node_table.names[node];
 
 			Transform3D xform;
 			if (has_ibms) {
@@ -1954,6 +3116,9 @@ Error FBXDocument::_create_skins(Ref<FBXState> p_state) {
 		}
 	}
 
+	// Then share them with the other files using the same import cache.
+	_share_skins(p_state);
+
 	return OK;
 }
 
@@ -1981,88 +3146,250 @@ bool FBXDocument::_skins_are_same(const Ref<Skin> p_skin_a, const Ref<Skin> p_sk
 	return true;
 }
 
+// Transforms that compare equal always quantize to the same value, so equal skins hash equally.
+static uint32_t _hash_quantized_real(real_t p_value, uint32_t p_hash) {
+	return hash_murmur3_one_64(uint64_t(int64_t(Math::floor(p_value * real_t(1 << 16)))), p_hash);
+}
+
+uint32_t FBXDocument::_get_skin_hash(const Ref<Skin> p_skin) {
+	const int bind_count = p_skin->get_bind_count();
+	uint32_t hash = hash_murmur3_one_32(uint32_t(bind_count));
+	for (int i = 0; i < bind_count; ++i) {
+		hash = hash_murmur3_one_32(uint32_t(p_skin->get_bind_bone(i)), hash);
+		hash = hash_murmur3_one_32(p_skin->get_bind_name(i).hash(), hash);
+
+		const Transform3D xform = p_skin->get_bind_pose(i);
+		for (int axis = 0; axis < 3; ++axis) {
+			hash = _hash_quantized_real(xform.basis.rows[axis].x, hash);
+			hash = _hash_quantized_real(xform.basis.rows[axis].y, hash);
+			hash = _hash_quantized_real(xform.basis.rows[axis].z, hash);
+			hash = _hash_quantized_real(xform.origin[axis], hash);
+		}
+	}
+	return hash_fmix32(hash);
+}
+
 void FBXDocument::_remove_duplicate_skins(Ref<FBXState> p_state) {
-	for (int i = 0; i < p_state->skins.size(); ++i) {
-		for (int j = i + 1; j < p_state->skins.size(); ++j) {
-			const Ref<Skin> skin_i = p_state->skins[i]->godot_skin;
-			const Ref<Skin> skin_j = p_state->skins[j]->godot_skin;
+	// Every skin is compared only against the first skin of each earlier fingerprint,
+	// and replaced by the first one that is actually identical.
+	HashMap<uint32_t, LocalVector<FBXSkinIndex>> unique_skins;
+	for (FBXSkinIndex skin_i = 0; skin_i < p_state->skins.size(); ++skin_i) {
+		const Ref<Skin> skin = p_state->skins[skin_i]->godot_skin;
+		LocalVector<FBXSkinIndex> &candidates = unique_skins[_get_skin_hash(skin)];
 
-			if (_skins_are_same(skin_i, skin_j)) {
+		bool found = false;
+		for (const FBXSkinIndex candidate_i : candidates) {
+			const Ref<Skin> candidate = p_state->skins[candidate_i]->godot_skin;
+			if (_skins_are_same(candidate, skin)) {
 				// replace it and delete the old
-				p_state->skins.write[j]->godot_skin = skin_i;
+				p_state->skins.write[skin_i]->godot_skin = candidate;
+				found = true;
+				break;
 			}
 		}
+		if (!found) {
+			candidates.push_back(skin_i);
+		}
 	}
 }
 
-Error FBXDocument::_parse_animations(Ref<FBXState> p_state) {
-	const ufbx_scene *fbx_scene = p_state->scene.get();
-	for (FBXAnimationIndex animation_i = 0; animation_i < static_cast<FBXAnimationIndex>(fbx_scene->anim_stacks.count); animation_i++) {
-		const ufbx_anim_stack *fbx_anim_stack = fbx_scene->anim_stacks[animation_i];
-
-		Ref<FBXAnimation> animation;
-		animation.instantiate();
+Ref<FBXImportCache> FBXDocument::_get_import_cache(Ref<FBXState> p_state) const {
+	if (p_state->import_cache.is_null() && batch) {
+		return batch->import_cache;
+	}
+	return p_state->import_cache;
+}
 
-		if (fbx_anim_stack->name.length > 0) {
-			const String anim_name = _as_string(fbx_anim_stack->name);
-			const String anim_name_lower = anim_name.to_lower();
-			if (anim_name_lower.begins_with("loop") || anim_name_lower.ends_with("loop") || anim_name_lower.begins_with("cycle") || anim_name_lower.ends_with("cycle")) {
-				animation->set_loop(true);
+void FBXDocument::_share_skins(Ref<FBXState> p_state) {
+	Ref<FBXImportCache> cache = _get_import_cache(p_state);
+	if (cache.is_null()) {
+		return;
+	}
+	MutexLock lock(cache->mutex);
+	for (FBXSkinIndex skin_i = 0; skin_i < p_state->skins.size(); ++skin_i) {
+		const Ref<Skin> skin = p_state->skins[skin_i]->godot_skin;
+		LocalVector<Ref<Skin>> &candidates = cache->skins[_get_skin_hash(skin)];
+
+		bool found = false;
+		for (const Ref<Skin> &candidate : candidates) {
+			if (candidate == skin || _skins_are_same(candidate, skin)) {
+				p_state->skins.write[skin_i]->godot_skin = candidate;
+				found = true;
+				break;
 			}
-			animation->set_name(_gen_unique_animation_name(p_state, anim_name));
 		}
+		if (!found) {
+			candidates.push_back(skin);
+		}
+	}
+}
 
-		animation->set_time_begin(fbx_anim_stack->time_begin);
-		animation->set_time_end(fbx_anim_stack->time_end);
+static void _copy_baked_key_value(const ufbx_vec3 &p_value, Vector3 &r_value) {
+	r_value = _as_vec3(p_value);
+}
 
-		ufbx_bake_opts opts = {};
-		ufbx_error error;
-		ufbx_unique_ptr<ufbx_baked_anim> fbx_baked_anim{ ufbx_bake_anim(fbx_scene, fbx_anim_stack->anim, &opts, &error) };
-		if (!fbx_baked_anim) {
-			char err_buf[512];
-			ufbx_format_error(err_buf, sizeof(err_buf), &error);
-			ERR_FAIL_V_MSG(FAILED, err_buf);
-		}
+static void _copy_baked_key_value(const ufbx_quat &p_value, Quaternion &r_value) {
+	r_value = _as_quaternion(p_value);
+}
 
-		for (const ufbx_baked_node &fbx_baked_node : fbx_baked_anim->nodes) {
-			const FBXNodeIndex node = fbx_baked_node.typed_id;
-			FBXAnimation::Track &track = animation->get_tracks()[node];
+template <class K, class T>
+static void _copy_baked_keys(const K &p_keys, FBXAnimation::Channel<T> &r_channel) {
+	const int key_count = int(p_keys.count);
+	r_channel.times.resize(key_count);
+	r_channel.values.resize(key_count);
+	real_t *times = r_channel.times.ptrw();
+	T *values = r_channel.values.ptrw();
+	for (int key_i = 0; key_i < key_count; key_i++) {
+		times[key_i] = float(p_keys.data[key_i].time);
+		_copy_baked_key_value(p_keys.data[key_i].value, values[key_i]);
+	}
+}
 
-			for (const ufbx_baked_vec3 &key : fbx_baked_node.translation_keys) {
-				track.position_track.times.push_back(float(key.time));
-				track.position_track.values.push_back(_as_vec3(key.value));
-			}
+Error FBXDocument::_parse_animation_stack(const FBXState *p_state, const ufbx_anim_stack *p_anim_stack, ParsedAnimation &r_animation) {
+	const ufbx_scene *fbx_scene = p_state->scene.get();
 
-			for (const ufbx_baked_quat &key : fbx_baked_node.rotation_keys) {
-				track.rotation_track.times.push_back(float(key.time));
-				track.rotation_track.values.push_back(_as_quaternion(key.value));
-			}
+	Ref<FBXAnimation> animation;
+	animation.instantiate();
+	r_animation.animation = animation;
 
-			for (const ufbx_baked_vec3 &key : fbx_baked_node.scale_keys) {
-				track.scale_track.times.push_back(float(key.time));
-				track.scale_track.values.push_back(_as_vec3(key.value));
-			}
+	if (p_anim_stack->name.length > 0) {
+		const String anim_name_lower = _as_string(p_anim_stack->name).to_lower();
+		if (anim_name_lower.begins_with("loop") || anim_name_lower.ends_with("loop") || anim_name_lower.begins_with("cycle") || anim_name_lower.ends_with("cycle")) {
+			animation->set_loop(true);
 		}
+	}
+
+	animation->set_time_begin(p_anim_stack->time_begin);
+	animation->set_time_end(p_anim_stack->time_end);
+
+	// Every take gets its own temporary arena, the scene itself is only read.
+	FBXArenaAllocator temp_arena;
+	ufbx_bake_opts opts = {};
+	opts.temp_allocator.allocator.alloc_fn = &FBXArenaAllocator::alloc_fn;
+	opts.temp_allocator.allocator.realloc_fn = &FBXArenaAllocator::realloc_fn;
+	opts.temp_allocator.allocator.free_fn = &FBXArenaAllocator::free_fn;
+	opts.temp_allocator.allocator.user = &temp_arena;
+	opts.temp_allocator.memory_limit = size_t(p_state->memory_limit);
+	opts.temp_allocator.allocation_limit = size_t(p_state->allocation_limit);
+	opts.result_allocator.memory_limit = size_t(p_state->memory_limit);
+	opts.result_allocator.allocation_limit = size_t(p_state->allocation_limit);
+	opts.resample_rate = p_state->bake_fps;
+	opts.max_keyframe_segments = size_t(p_state->bake_max_keyframe_segments);
+	opts.key_reduction_enabled = p_state->bake_key_reduction;
+	opts.key_reduction_rotation = p_state->bake_key_reduction_rotation;
+	opts.key_reduction_threshold = p_state->bake_key_reduction_threshold;
+	opts.key_reduction_passes = size_t(p_state->bake_key_reduction_passes);
+	ufbx_error error;
+	ufbx_unique_ptr<ufbx_baked_anim> fbx_baked_anim{ ufbx_bake_anim(fbx_scene, p_anim_stack->anim, &opts, &error) };
+	if (!fbx_baked_anim) {
+		char err_buf[512];
+		ufbx_format_error(err_buf, sizeof(err_buf), &error);
+		r_animation.error_message = err_buf;
+		return FAILED;
+	}
 
-		for (const ufbx_baked_element &fbx_baked_element : fbx_baked_anim->elements) {
-			const ufbx_element *fbx_element = fbx_scene->elements[fbx_baked_element.element_id];
+	for (const ufbx_baked_node &fbx_baked_node : fbx_baked_anim->nodes) {
+		const FBXNodeIndex node = fbx_baked_node.typed_id;
+		FBXAnimation::Track &track = animation->get_tracks()[node];
 
-			for (const ufbx_baked_prop &fbx_baked_prop : fbx_baked_element.props) {
-				String prop_name = _as_string(fbx_baked_prop.name);
+		_copy_baked_keys(fbx_baked_node.translation_keys, track.position_track);
+		_copy_baked_keys(fbx_baked_node.rotation_keys, track.rotation_track);
+		_copy_baked_keys(fbx_baked_node.scale_keys, track.scale_track);
+	}
 
-				if (fbx_element->type == UFBX_ELEMENT_BLEND_CHANNEL && prop_name == UFBX_DeformPercent) {
-					const ufbx_blend_channel *fbx_blend_channel = ufbx_as_blend_channel(fbx_element);
+	for (const ufbx_baked_element &fbx_baked_element : fbx_baked_anim->elements) {
+		const ufbx_element *fbx_element = fbx_scene->elements[fbx_baked_element.element_id];
 
-					int blend_i = fbx_blend_channel->typed_id;
-					FBXAnimation::BlendShapeTrack &track = animation->get_blend_tracks()[blend_i];
+		for (const ufbx_baked_prop &fbx_baked_prop : fbx_baked_element.props) {
+			String prop_name = _as_string(fbx_baked_prop.name);
 
-					for (const ufbx_baked_vec3 &key : fbx_baked_prop.keys) {
-						track.weight_track.times.push_back(float(key.time));
-						track.weight_track.values.push_back(real_t(key.value.x / 100.0));
-					}
+			if (fbx_element->type == UFBX_ELEMENT_BLEND_CHANNEL && prop_name == UFBX_DeformPercent) {
+				const ufbx_blend_channel *fbx_blend_channel = ufbx_as_blend_channel(fbx_element);
+
+				int blend_i = fbx_blend_channel->typed_id;
+				FBXAnimation::BlendShapeTrack &track = animation->get_blend_tracks()[blend_i];
+
+				const int key_count = int(fbx_baked_prop.keys.count);
+				track.weight_track.times.resize(key_count);
+				track.weight_track.values.resize(key_count);
+				real_t *times = track.weight_track.times.ptrw();
+				real_t *values = track.weight_track.values.ptrw();
+				for (int key_i = 0; key_i < key_count; key_i++) {
+					const ufbx_baked_vec3 &key = fbx_baked_prop.keys.data[key_i];
+					times[key_i] = float(key.time);
+					values[key_i] = real_t(key.value.x / 100.0);
 				}
 			}
 		}
+	}
+
+	return OK;
+}
+
+void FBXDocument::_parse_animations_task(uint32_t p_index, ParseAnimationsTask *p_task) {
+	ParsedAnimation &parsed_animation = p_task->animations.write[p_index];
+	if (!cancel_requested.is_set()) {
+		if (p_task->profile) {
+			_begin_profile_entry(parsed_animation.profile);
+		}
+		parsed_animation.error = _parse_animation_stack(p_task->state, p_task->scene->anim_stacks[p_task->anim_stacks[p_index]], parsed_animation);
+		if (p_task->profile) {
+			_end_profile_entry(parsed_animation.profile);
+		}
+	}
+	p_task->completed.increment();
+}
+
+Error FBXDocument::_parse_animations(Ref<FBXState> p_state) {
+	const ufbx_scene *fbx_scene = p_state->scene.get();
+
+	// Bake and convert the takes on worker threads, `ufbx_bake_anim()` only reads the scene.
+	// Unique names and the final append happen afterwards in stack order.
+	ParseAnimationsTask task;
+	task.state = p_state.ptr();
+	task.scene = fbx_scene;
+	for (uint32_t stack_i = 0; stack_i < uint32_t(fbx_scene->anim_stacks.count); stack_i++) {
+		if (p_state->animation_filter.is_empty() || p_state->animation_filter.has(_as_string(fbx_scene->anim_stacks[stack_i]->name))) {
+			task.anim_stacks.push_back(stack_i);
+		}
+	}
+	const uint32_t anim_stack_count = task.anim_stacks.size();
+	task.animations.resize(anim_stack_count);
+	task.profile = p_state->profiling_enabled && p_state->detailed_profiling;
+
+	Vector<uint8_t> cache_key;
+	const String cache_file = _get_cache_file(p_state, "animations", vformat("%f;%d;%d;%d;%f;%d;%s", p_state->bake_fps, p_state->bake_max_keyframe_segments, p_state->bake_key_reduction, p_state->bake_key_reduction_rotation, p_state->bake_key_reduction_threshold, p_state->bake_key_reduction_passes, String(";").join(p_state->animation_filter)), cache_key);
+	const bool cached = !cache_file.is_empty() && _load_cached_animations(cache_file, cache_key, task.animations);
+	if (cached) {
+		print_verbose("FBX: Loaded cached animations from: " + cache_file);
+	} else if (anim_stack_count > 0) {
+		WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &FBXDocument::_parse_animations_task, &task, int(anim_stack_count), -1, true, SNAME("FBXParseAnimations"));
+		_wait_for_group_task(group_id, PROGRESS_STAGE_ANIMATIONS, task.completed, anim_stack_count);
+		if (!cache_file.is_empty() && !cancel_requested.is_set()) {
+			_save_cached_animations(cache_file, cache_key, task.animations);
+		}
+	}
+	if (cancel_requested.is_set()) {
+		return OK;
+	}
+
+	for (uint32_t animation_i = 0; animation_i < anim_stack_count; animation_i++) {
+		const ufbx_anim_stack *fbx_anim_stack = fbx_scene->anim_stacks[task.anim_stacks[animation_i]];
+		ParsedAnimation &parsed_animation = task.animations.write[animation_i];
+		ERR_FAIL_COND_V_MSG(parsed_animation.error != OK, parsed_animation.error, parsed_animation.error_message);
+
+		Ref<FBXAnimation> animation = parsed_animation.animation;
+		if (fbx_anim_stack->name.length > 0) {
+			animation->set_name(_gen_unique_animation_name(p_state, _as_string(fbx_anim_stack->name)));
+		}
+
+		if (task.profile) {
+			FBXState::ProfileEntry entry = parsed_animation.profile;
+			entry.name = _as_string(fbx_anim_stack->name);
+			entry.category = "animation";
+			entry.count = int64_t(animation->get_tracks().size());
+			p_state->add_profile_entry(entry);
+		}
 
 		p_state->animations.push_back(animation);
 	}
@@ -2072,50 +3399,301 @@ Error FBXDocument::_parse_animations(Ref<FBXState> p_state) {
 	return OK;
 }
 
-void FBXDocument::_assign_node_names(Ref<FBXState> p_state) {
-	for (int i = 0; i < p_state->nodes.size(); i++) {
-		Ref<FBXNode> fbx_node = p_state->nodes[i];
+// Cache files are a small header followed by one `encode_variant()` blob. Packed arrays are
+// stored as raw copies, so reading them back from a mapped file is a plain memcpy per array.
+// Each source file has one cache file per kind, and the header holds the MD5 of the key it
+// was written for, so a changed source or option set overwrites the entry instead of adding one.
+static const uint32_t FBX_CACHE_MAGIC = 0x43584246; // "FBXC"
+static const uint32_t FBX_CACHE_VERSION = 2;
+static const int FBX_CACHE_KEY_SIZE = 16;
+static const int FBX_CACHE_HEADER_SIZE = 8 + FBX_CACHE_KEY_SIZE;
+
+static bool _read_cache_file(const String &p_cache_file, const Vector<uint8_t> &p_key, Variant &r_payload) {
+	ERR_FAIL_COND_V(p_key.size() != FBX_CACHE_KEY_SIZE, false);
+	FBXMappedFile mapped_file;
+	Vector<uint8_t> file_bytes;
+	const uint8_t *data = nullptr;
+	size_t size = 0;
+	if (mapped_file.open(p_cache_file)) {
+		data = mapped_file.data;
+		size = mapped_file.size;
+	} else {
+		if (!FileAccess::exists(p_cache_file)) {
+			return false;
+		}
+		file_bytes = FileAccess::get_file_as_bytes(p_cache_file);
+		data = file_bytes.ptr();
+		size = size_t(file_bytes.size());
+	}
+	if (size < size_t(FBX_CACHE_HEADER_SIZE) || size > size_t(INT32_MAX) || decode_uint32(data) != FBX_CACHE_MAGIC || decode_uint32(data + 4) != FBX_CACHE_VERSION || memcmp(data + 8, p_key.ptr(), FBX_CACHE_KEY_SIZE) != 0) {
+		return false;
+	}
+	return decode_variant(r_payload, data + FBX_CACHE_HEADER_SIZE, int(size - FBX_CACHE_HEADER_SIZE)) == OK;
+}
+
+static void _write_cache_file(const String &p_cache_file, const Vector<uint8_t> &p_key, const Variant &p_payload) {
+	ERR_FAIL_COND(p_key.size() != FBX_CACHE_KEY_SIZE);
+	int len = 0;
+	Error err = encode_variant(p_payload, nullptr, len);
+	ERR_FAIL_COND(err != OK);
+	Vector<uint8_t> buffer;
+	buffer.resize(FBX_CACHE_HEADER_SIZE + len);
+	uint8_t *w = buffer.ptrw();
+	encode_uint32(FBX_CACHE_MAGIC, w);
+	encode_uint32(FBX_CACHE_VERSION, w + 4);
+	memcpy(w + 8, p_key.ptr(), FBX_CACHE_KEY_SIZE);
+	err = encode_variant(p_payload, w + FBX_CACHE_HEADER_SIZE, len);
+	ERR_FAIL_COND(err != OK);
+
+	const String base_dir = p_cache_file.get_base_dir();
+	if (!DirAccess::exists(base_dir)) {
+		err = DirAccess::make_dir_recursive_absolute(base_dir);
+		ERR_FAIL_COND_MSG(err != OK, "FBX: Could not create cache directory: " + base_dir);
+	}
+	// Write next to the final file and rename, so readers never see a partial cache file.
+	const String temp_file = p_cache_file + ".tmp";
+	{
+		Ref<FileAccess> file = FileAccess::open(temp_file, FileAccess::WRITE, &err);
+		ERR_FAIL_COND_MSG(err != OK, "FBX: Could not write cache file: " + temp_file);
+		file->store_buffer(buffer.ptr(), buffer.size());
+	}
+	Ref<DirAccess> dir = DirAccess::create_for_path(base_dir);
+	ERR_FAIL_COND(dir.is_null());
+	if (dir->file_exists(p_cache_file)) {
+		dir->remove(p_cache_file);
+	}
+	err = dir->rename(temp_file, p_cache_file);
+	ERR_FAIL_COND_MSG(err != OK, "FBX: Could not write cache file: " + p_cache_file);
+}
+
+static Vector<real_t> _quaternions_to_reals(const Vector<Quaternion> &p_quaternions) {
+	Vector<real_t> ret;
+	ret.resize(p_quaternions.size() * 4);
+	real_t *w = ret.ptrw();
+	for (int i = 0; i < p_quaternions.size(); i++) {
+		const Quaternion &q = p_quaternions[i];
+		w[i * 4 + 0] = q.x;
+		w[i * 4 + 1] = q.y;
+		w[i * 4 + 2] = q.z;
+		w[i * 4 + 3] = q.w;
+	}
+	return ret;
+}
+
+static Vector<Quaternion> _reals_to_quaternions(const Vector<real_t> &p_reals) {
+	Vector<Quaternion> ret;
+	ret.resize(p_reals.size() / 4);
+	Quaternion *w = ret.ptrw();
+	const real_t *r = p_reals.ptr();
+	for (int i = 0; i < ret.size(); i++) {
+		w[i] = Quaternion(r[i * 4 + 0], r[i * 4 + 1], r[i * 4 + 2], r[i * 4 + 3]);
+	}
+	return ret;
+}
+
+String FBXDocument::_get_cache_file(Ref<FBXState> p_state, const String &p_kind, const String &p_options, Vector<uint8_t> &r_key) {
+	if (p_state->cache_path.is_empty() || p_state->source_hash.is_empty()) {
+		return String();
+	}
+	// The engine build and the ufbx version are part of the key, so a rebuilt importer never
+	// reads surfaces or tracks an older build produced. Buffers without a path get one file per hash.
+	r_key = vformat("%s;%s;%d;%s;%s;%d;%s", p_state->source_hash, p_kind, FBX_CACHE_VERSION, VERSION_FULL_BUILD, VERSION_HASH, uint32_t(UFBX_VERSION), p_options).md5_buffer();
+	const String source = p_state->source_path.is_empty() ? p_state->source_hash : p_state->source_path;
+	const String name = vformat("%s;%s", source, p_kind).md5_text();
+	return p_state->cache_path.path_join(name.substr(0, 2)).path_join(name + "." + p_kind);
+}
+
+bool FBXDocument::_load_cached_meshes(const String &p_cache_file, const Vector<uint8_t> &p_key, Vector<ParsedMesh> &r_meshes) {
+	Variant payload;
+	if (!_read_cache_file(p_cache_file, p_key, payload) || payload.get_type() != Variant::ARRAY) {
+		return false;
+	}
+	const Array meshes = payload;
+	if (meshes.size() != r_meshes.size()) {
+		return false;
+	}
+	// Decode into a copy, so a corrupt entry leaves `r_meshes` untouched for the regular parse.
+	Vector<ParsedMesh> cached_meshes;
+	cached_meshes.resize(meshes.size());
+	for (int mesh_i = 0; mesh_i < meshes.size(); mesh_i++) {
+		const Array mesh = meshes[mesh_i];
+		ERR_FAIL_COND_V(mesh.size() != 2, false);
+		ParsedMesh &parsed_mesh = cached_meshes.write[mesh_i];
+		parsed_mesh.skin = mesh[0];
+		const Array surfaces = mesh[1];
+		parsed_mesh.surfaces.resize(surfaces.size());
+		for (int surface_i = 0; surface_i < surfaces.size(); surface_i++) {
+			const Array surface = surfaces[surface_i];
+			ERR_FAIL_COND_V(surface.size() != 6, false);
+			MeshSurface &mesh_surface = parsed_mesh.surfaces.write[surface_i];
+			mesh_surface.primitive = Mesh::PrimitiveType(int(surface[0]));
+			mesh_surface.arrays = surface[1];
+			mesh_surface.morphs = surface[2];
+			mesh_surface.flags = surface[3];
+			mesh_surface.material_part = surface[4];
+			mesh_surface.has_vertex_color = surface[5];
+		}
+	}
+	r_meshes = cached_meshes;
+	return true;
+}
+
+void FBXDocument::_save_cached_meshes(const String &p_cache_file, const Vector<uint8_t> &p_key, const Vector<ParsedMesh> &p_meshes) {
+	Array meshes;
+	for (const ParsedMesh &parsed_mesh : p_meshes) {
+		if (parsed_mesh.error != OK) {
+			return;
+		}
+		Array surfaces;
+		for (const MeshSurface &mesh_surface : parsed_mesh.surfaces) {
+			Array surface;
+			surface.push_back(int(mesh_surface.primitive));
+			surface.push_back(mesh_surface.arrays);
+			surface.push_back(mesh_surface.morphs);
+			surface.push_back(mesh_surface.flags);
+			surface.push_back(mesh_surface.material_part);
+			surface.push_back(mesh_surface.has_vertex_color);
+			surfaces.push_back(surface);
+		}
+		Array mesh;
+		mesh.push_back(parsed_mesh.skin);
+		mesh.push_back(surfaces);
+		meshes.push_back(mesh);
+	}
+	_write_cache_file(p_cache_file, p_key, meshes);
+}
+
+bool FBXDocument::_load_cached_animations(const String &p_cache_file, const Vector<uint8_t> &p_key, Vector<ParsedAnimation> &r_animations) {
+	Variant payload;
+	if (!_read_cache_file(p_cache_file, p_key, payload) || payload.get_type() != Variant::ARRAY) {
+		return false;
+	}
+	const Array animations = payload;
+	if (animations.size() != r_animations.size()) {
+		return false;
+	}
+	Vector<ParsedAnimation> cached_animations;
+	cached_animations.resize(animations.size());
+	for (int animation_i = 0; animation_i < animations.size(); animation_i++) {
+		const Array cached_animation = animations[animation_i];
+		ERR_FAIL_COND_V(cached_animation.size() != 5, false);
+		Ref<FBXAnimation> animation;
+		animation.instantiate();
+		animation->set_loop(cached_animation[0]);
+		animation->set_time_begin(cached_animation[1]);
+		animation->set_time_end(cached_animation[2]);
+
+		const Array tracks = cached_animation[3];
+		for (int track_i = 0; track_i < tracks.size(); track_i++) {
+			const Array cached_track = tracks[track_i];
+			ERR_FAIL_COND_V(cached_track.size() != 7, false);
+			FBXAnimation::Track &track = animation->get_tracks()[int(cached_track[0])];
+			track.position_track.times = cached_track[1];
+			track.position_track.values = cached_track[2];
+			track.rotation_track.times = cached_track[3];
+			track.rotation_track.values = _reals_to_quaternions(cached_track[4]);
+			track.scale_track.times = cached_track[5];
+			track.scale_track.values = cached_track[6];
+		}
+
+		const Array blend_tracks = cached_animation[4];
+		for (int track_i = 0; track_i < blend_tracks.size(); track_i++) {
+			const Array cached_track = blend_tracks[track_i];
+			ERR_FAIL_COND_V(cached_track.size() != 3, false);
+			FBXAnimation::BlendShapeTrack &track = animation->get_blend_tracks()[int(cached_track[0])];
+			track.weight_track.times = cached_track[1];
+			track.weight_track.values = cached_track[2];
+		}
+
+		cached_animations.write[animation_i].animation = animation;
+	}
+	r_animations = cached_animations;
+	return true;
+}
+
+void FBXDocument::_save_cached_animations(const String &p_cache_file, const Vector<uint8_t> &p_key, const Vector<ParsedAnimation> &p_animations) {
+	Array animations;
+	for (const ParsedAnimation &parsed_animation : p_animations) {
+		if (parsed_animation.error != OK || parsed_animation.animation.is_null()) {
+			return;
+		}
+		const Ref<FBXAnimation> animation = parsed_animation.animation;
+
+		Array tracks;
+		for (const KeyValue<int, FBXAnimation::Track> &E : animation->get_tracks()) {
+			Array track;
+			track.push_back(E.key);
+			track.push_back(E.value.position_track.times);
+			track.push_back(E.value.position_track.values);
+			track.push_back(E.value.rotation_track.times);
+			track.push_back(_quaternions_to_reals(E.value.rotation_track.values));
+			track.push_back(E.value.scale_track.times);
+			track.push_back(E.value.scale_track.values);
+			tracks.push_back(track);
+		}
 
+		Array blend_tracks;
+		for (const KeyValue<int, FBXAnimation::BlendShapeTrack> &E : animation->get_blend_tracks()) {
+			Array track;
+			track.push_back(E.key);
+			track.push_back(E.value.weight_track.times);
+			track.push_back(E.value.weight_track.values);
+			blend_tracks.push_back(track);
+		}
+
+		Array cached_animation;
+		cached_animation.push_back(animation->get_loop());
+		cached_animation.push_back(animation->get_time_begin());
+		cached_animation.push_back(animation->get_time_end());
+		cached_animation.push_back(tracks);
+		cached_animation.push_back(blend_tracks);
+		animations.push_back(cached_animation);
+	}
+	_write_cache_file(p_cache_file, p_key, animations);
+}
+
+void FBXDocument::_assign_node_names(Ref<FBXState> p_state) {
+	FBXNodeTable &table = p_state->node_table;
+	for (int i = 0; i < table.size(); i++) {
 		// Any joints get unique names generated when the skeleton is made, unique to the skeleton
-		if (fbx_node->skeleton >= 0) {
+		if (table.skeletons[i] >= 0) {
 			continue;
 		}
 
-		if (fbx_node->get_name().is_empty()) {
-			if (fbx_node->mesh >= 0) {
-				fbx_node->set_name(_gen_unique_name(p_state, "Mesh"));
+		if (table.names[i].is_empty()) {
+			if (table.meshes[i] >= 0) {
+				table.names[i] = _gen_unique_name(p_state, "Mesh");
 			} else {
-				fbx_node->set_name(_gen_unique_name(p_state, "Node"));
+				table.names[i] = _gen_unique_name(p_state, "Node");
 			}
 		}
 
-		fbx_node->set_name(_gen_unique_name(p_state, fbx_node->get_name()));
+		table.names[i] = _gen_unique_name(p_state, table.names[i]);
 	}
 }
 
 BoneAttachment3D *FBXDocument::_generate_bone_attachment(Ref<FBXState> p_state, Skeleton3D *p_skeleton, const FBXNodeIndex p_node_index, const FBXNodeIndex p_bone_index) {
-	Ref<FBXNode> fbx_node = p_state->nodes[p_node_index];
-	Ref<FBXNode> bone_node = p_state->nodes[p_bone_index];
+	const FBXNodeTable &table = p_state->node_table;
 	BoneAttachment3D *bone_attachment = memnew(BoneAttachment3D);
-	print_verbose("FBX: Creating bone attachment for: " + fbx_node->get_name());
+	print_verbose("FBX: Creating bone attachment for: " + table.names[p_node_index]);
 
-	ERR_FAIL_COND_V(!bone_node->joint, nullptr);
+	ERR_FAIL_COND_V(!table.joints[p_bone_index], nullptr);
 
-	bone_attachment->set_bone_name(bone_node->get_name());
+	bone_attachment->set_bone_name(table.names[p_bone_index]);
 
 	return bone_attachment;
 }
 
 ImporterMeshInstance3D *FBXDocument::_generate_mesh_instance(Ref<FBXState> p_state, const FBXNodeIndex p_node_index) {
-	Ref<FBXNode> fbx_node = p_state->nodes[p_node_index];
+	const FBXMeshIndex mesh_i = p_state->node_table.meshes[p_node_index];
 
-	ERR_FAIL_INDEX_V(fbx_node->mesh, p_state->meshes.size(), nullptr);
+	ERR_FAIL_INDEX_V(mesh_i, p_state->meshes.size(), nullptr);
 
 	ImporterMeshInstance3D *mi = memnew(ImporterMeshInstance3D);
-	print_verbose("FBX: Creating mesh for: " + fbx_node->get_name());
+	print_verbose("FBX: Creating mesh for: " + p_state->node_table.names[p_node_index]);
 
 	p_state->scene_mesh_instances.insert(p_node_index, mi);
-	Ref<FBXMesh> mesh = p_state->meshes.write[fbx_node->mesh];
+	Ref<FBXMesh> mesh = p_state->meshes.write[mesh_i];
 	if (mesh.is_null()) {
 		return mi;
 	}
@@ -2127,22 +3705,148 @@ ImporterMeshInstance3D *FBXDocument::_generate_mesh_instance(Ref<FBXState> p_sta
 	return mi;
 }
 
+void FBXDocument::_determine_multimesh_instances(Ref<FBXState> p_state) {
+	p_state->multimesh_instances.clear();
+	p_state->multimesh_nodes.clear();
+	if (p_state->multimesh_instance_threshold <= 0) {
+		return;
+	}
+
+	// Nodes whose transform or any parent transform is animated can't be baked into instances.
+	HashSet<FBXNodeIndex> animated_nodes;
+	for (const Ref<FBXAnimation> &animation : p_state->animations) {
+		for (const KeyValue<int, FBXAnimation::Track> &E : animation->get_tracks()) {
+			animated_nodes.insert(E.key);
+		}
+	}
+
+	// Walk down from the roots, only leaf nodes on fully static, bone-free paths are candidates.
+	HashMap<FBXMeshIndex, Vector<FBXNodeIndex>> candidates;
+	const FBXNodeTable &table = p_state->node_table;
+	LocalVector<FBXNodeIndex> stack;
+	for (const FBXNodeIndex root_i : p_state->root_nodes) {
+		stack.push_back(root_i);
+	}
+	while (!stack.is_empty()) {
+		const FBXNodeIndex node_i = stack[stack.size() - 1];
+		stack.remove_at(stack.size() - 1);
+		if (table.skeletons[node_i] >= 0 || animated_nodes.has(node_i)) {
+			continue;
+		}
+		const FBXNodeTable::Range children = table.get_children(node_i);
+		if (children.is_empty()) {
+			if (table.meshes[node_i] >= 0 && table.skins[node_i] < 0) {
+				candidates[table.meshes[node_i]].push_back(node_i);
+			}
+			continue;
+		}
+		for (const FBXNodeIndex child_i : children) {
+			stack.push_back(child_i);
+		}
+	}
+
+	for (KeyValue<FBXMeshIndex, Vector<FBXNodeIndex>> &E : candidates) {
+		if (E.value.size() < p_state->multimesh_instance_threshold) {
+			continue;
+		}
+		ERR_CONTINUE(E.key >= p_state->meshes.size());
+		const Ref<ImporterMesh> import_mesh = p_state->meshes[E.key]->get_mesh();
+		if (import_mesh.is_null() || import_mesh->get_surface_count() == 0 || import_mesh->get_blend_shape_count() > 0) {
+			continue;
+		}
+		// Keep the instances in node order, so the instance buffer is the same on every import.
+		E.value.sort();
+		for (const FBXNodeIndex node_i : E.value) {
+			p_state->multimesh_nodes.insert(node_i);
+		}
+		p_state->multimesh_instances.insert(E.key, E.value);
+	}
+}
+
+void FBXDocument::_generate_multimesh_instances(Ref<FBXState> p_state, Node *p_scene_root) {
+	if (p_state->multimesh_instances.is_empty()) {
+		return;
+	}
+
+	// Transforms relative to the scene root, every node in the chain is static.
+	LocalVector<Transform3D> root_xforms;
+	LocalVector<bool> has_root_xform;
+	root_xforms.resize(p_state->node_table.size());
+	has_root_xform.resize(p_state->node_table.size());
+	for (bool &has : has_root_xform) {
+		has = false;
+	}
+	LocalVector<FBXNodeIndex> chain;
+
+	LocalVector<FBXMeshIndex> meshes;
+	for (const KeyValue<FBXMeshIndex, Vector<FBXNodeIndex>> &E : p_state->multimesh_instances) {
+		meshes.push_back(E.key);
+	}
+	meshes.sort();
+	for (const FBXMeshIndex mesh_i : meshes) {
+		const Vector<FBXNodeIndex> &instances = p_state->multimesh_instances[mesh_i];
+		Ref<ImporterMesh> import_mesh = p_state->meshes[mesh_i]->get_mesh();
+
+		// 12 floats per instance, the basis rows each followed by the matching origin component.
+		Vector<float> buffer;
+		buffer.resize(instances.size() * 12);
+		float *w = buffer.ptrw();
+		for (int instance_i = 0; instance_i < instances.size(); instance_i++) {
+			chain.clear();
+			for (FBXNodeIndex node_i = instances[instance_i]; node_i >= 0 && !has_root_xform[node_i]; node_i = p_state->node_table.parents[node_i]) {
+				chain.push_back(node_i);
+			}
+			for (int chain_i = int(chain.size()) - 1; chain_i >= 0; chain_i--) {
+				const FBXNodeIndex node_i = chain[chain_i];
+				const FBXNodeIndex parent_i = p_state->node_table.parents[node_i];
+				root_xforms[node_i] = parent_i >= 0 ? root_xforms[parent_i] * p_state->node_table.xforms[node_i] : p_state->node_table.xforms[node_i];
+				has_root_xform[node_i] = true;
+			}
+			const Transform3D &xform = root_xforms[instances[instance_i]];
+			float *instance_w = w + instance_i * 12;
+			for (int row = 0; row < 3; row++) {
+				instance_w[row * 4 + 0] = xform.basis.rows[row].x;
+				instance_w[row * 4 + 1] = xform.basis.rows[row].y;
+				instance_w[row * 4 + 2] = xform.basis.rows[row].z;
+				instance_w[row * 4 + 3] = xform.origin[row];
+			}
+		}
+
+		Ref<MultiMesh> multimesh;
+		multimesh.instantiate();
+		multimesh->set_transform_format(MultiMesh::TRANSFORM_3D);
+		multimesh->set_mesh(import_mesh->get_mesh());
+		multimesh->set_instance_count(instances.size());
+		multimesh->set_buffer(buffer);
+
+		MultiMeshInstance3D *multimesh_instance = memnew(MultiMeshInstance3D);
+		multimesh_instance->set_multimesh(multimesh);
+		p_scene_root->add_child(multimesh_instance, true);
+		multimesh_instance->set_owner(p_scene_root);
+		multimesh_instance->set_name(_gen_unique_name(p_state, import_mesh->get_name() + "_MultiMesh"));
+		print_verbose(vformat("FBX: Generated %d instances of mesh %s as a MultiMeshInstance3D.", instances.size(), import_mesh->get_name()));
+	}
+}
+
 Node3D *FBXDocument::_generate_spatial(Ref<FBXState> p_state, const FBXNodeIndex p_node_index) {
-	Ref<FBXNode> fbx_node = p_state->nodes[p_node_index];
+	const FBXNodeTable &table = p_state->node_table;
 
 	Node3D *spatial = memnew(Node3D);
-	print_verbose("FBX: Converting spatial: " + fbx_node->get_name());
+	print_verbose("FBX: Converting spatial: " + table.names[p_node_index]);
 
 	return spatial;
 }
 
 void FBXDocument::_generate_scene_node(Ref<FBXState> p_state, const FBXNodeIndex p_node_index, Node *p_scene_parent, Node *p_scene_root) {
-	Ref<FBXNode> fbx_node = p_state->nodes[p_node_index];
+	const FBXNodeTable &table = p_state->node_table;
 
-	if (fbx_node->skeleton >= 0) {
+	if (table.skeletons[p_node_index] >= 0) {
 		_generate_skeleton_bone_node(p_state, p_node_index, p_scene_parent, p_scene_root);
 		return;
 	}
+	if (p_state->multimesh_nodes.has(p_node_index)) {
+		return; // Part of a MultiMeshInstance3D, see `_generate_multimesh_instances()`.
+	}
 
 	Node3D *current_node = nullptr;
 
@@ -2152,28 +3856,30 @@ void FBXDocument::_generate_scene_node(Ref<FBXState> p_state, const FBXNodeIndex
 	const bool non_bone_parented_to_skeleton = active_skeleton;
 
 	// skinned meshes must not be placed in a bone attachment.
-	if (non_bone_parented_to_skeleton && fbx_node->skin < 0) {
+	if (non_bone_parented_to_skeleton && table.skins[p_node_index] < 0) {
 		// Bone Attachment - Parent Case
-		BoneAttachment3D *bone_attachment = _generate_bone_attachment(p_state, active_skeleton, p_node_index, fbx_node->parent);
+		BoneAttachment3D *bone_attachment = _generate_bone_attachment(p_state, active_skeleton, p_node_index, table.parents[p_node_index]);
 
 		p_scene_parent->add_child(bone_attachment, true);
 		bone_attachment->set_owner(p_scene_root);
 
 		// There is no fbx_node that represent this, so just directly create a unique name
-		bone_attachment->set_name(fbx_node->get_name());
+		bone_attachment->set_name(table.names[p_node_index]);
 
 		// We change the scene_parent to our bone attachment now. We do not set current_node because we want to make the node
 		// and attach it to the bone_attachment
 		p_scene_parent = bone_attachment;
 	}
+	// Check if any FBXDocumentExtension classes want to generate a node for us.
+	current_node = _take_extension_scene_node(p_state, p_node_index, p_scene_parent);
 	if (!current_node) {
-		if (fbx_node->skin >= 0 && fbx_node->mesh >= 0 && !fbx_node->children.is_empty()) {
+		if (table.skins[p_node_index] >= 0 && table.meshes[p_node_index] >= 0 && !table.get_children(p_node_index).is_empty()) {
 			current_node = _generate_spatial(p_state, p_node_index);
 			Node3D *mesh_inst = _generate_mesh_instance(p_state, p_node_index);
-			mesh_inst->set_name(fbx_node->get_name());
+			mesh_inst->set_name(table.names[p_node_index]);
 
 			current_node->add_child(mesh_inst, true);
-		} else if (fbx_node->mesh >= 0) {
+		} else if (table.meshes[p_node_index] >= 0) {
 			current_node = _generate_mesh_instance(p_state, p_node_index);
 		} else {
 			current_node = _generate_spatial(p_state, p_node_index);
@@ -2189,31 +3895,31 @@ void FBXDocument::_generate_scene_node(Ref<FBXState> p_state, const FBXNodeIndex
 		args.append(p_scene_root);
 		current_node->propagate_call(StringName("set_owner"), args);
 	}
-	current_node->set_transform(fbx_node->xform);
-	current_node->set_name(fbx_node->get_name());
+	current_node->set_transform(table.xforms[p_node_index]);
+	current_node->set_name(table.names[p_node_index]);
 
 	p_state->scene_nodes.insert(p_node_index, current_node);
-	for (int i = 0; i < fbx_node->children.size(); ++i) {
-		_generate_scene_node(p_state, fbx_node->children[i], current_node, p_scene_root);
+	for (const FBXNodeIndex child_i : table.get_children(p_node_index)) {
+		_generate_scene_node(p_state, child_i, current_node, p_scene_root);
 	}
 }
 
 void FBXDocument::_generate_skeleton_bone_node(Ref<FBXState> p_state, const FBXNodeIndex p_node_index, Node *p_scene_parent, Node *p_scene_root) {
-	Ref<FBXNode> fbx_node = p_state->nodes[p_node_index];
+	const FBXNodeTable &table = p_state->node_table;
 
 	Node3D *current_node = nullptr;
 
-	Skeleton3D *skeleton = p_state->skeletons[fbx_node->skeleton]->godot_skeleton;
+	Skeleton3D *skeleton = p_state->skeletons[table.skeletons[p_node_index]]->godot_skeleton;
 	// In this case, this node is already a bone in skeleton.
-	const bool is_skinned_mesh = (fbx_node->skin >= 0 && fbx_node->mesh >= 0);
-	const bool requires_extra_node = (fbx_node->mesh >= 0);
+	const bool is_skinned_mesh = (table.skins[p_node_index] >= 0 && table.meshes[p_node_index] >= 0);
+	const bool requires_extra_node = (table.meshes[p_node_index] >= 0);
 
 	Skeleton3D *active_skeleton = Object::cast_to<Skeleton3D>(p_scene_parent);
 	if (active_skeleton != skeleton) {
 		if (active_skeleton) {
 			// Should no longer be possible.
 			ERR_PRINT(vformat("FBX: Generating scene detected direct parented Skeletons at node %d", p_node_index));
-			BoneAttachment3D *bone_attachment = _generate_bone_attachment(p_state, active_skeleton, p_node_index, fbx_node->parent);
+			BoneAttachment3D *bone_attachment = _generate_bone_attachment(p_state, active_skeleton, p_node_index, table.parents[p_node_index]);
 			p_scene_parent->add_child(bone_attachment, true);
 			bone_attachment->set_owner(p_scene_root);
 			// There is no fbx_node that represent this, so just directly create a unique name
@@ -2242,23 +3948,17 @@ void FBXDocument::_generate_skeleton_bone_node(Ref<FBXState> p_state, const FBXN
 			bone_attachment->set_owner(p_scene_root);
 
 			// There is no fbx_node that represent this, so just directly create a unique name
-			bone_attachment->set_name(fbx_node->get_name());
+			bone_attachment->set_name(table.names[p_node_index]);
 
 			// We change the scene_parent to our bone attachment now. We do not set current_node because we want to make the node
 			// and attach it to the bone_attachment
 			p_scene_parent = bone_attachment;
 		}
 		// Check if any FBXDocumentExtension classes want to generate a node for us.
-		for (Ref<FBXDocumentExtension> ext : document_extensions) {
-			ERR_CONTINUE(ext.is_null());
-			current_node = ext->generate_scene_node(p_state, fbx_node, p_scene_parent);
-			if (current_node) {
-				break;
-			}
-		}
+		current_node = _take_extension_scene_node(p_state, p_node_index, p_scene_parent);
 		// If none of our FBXDocumentExtension classes generated us a node, we generate one.
 		if (!current_node) {
-			if (fbx_node->mesh >= 0) {
+			if (table.meshes[p_node_index] >= 0) {
 				current_node = _generate_mesh_instance(p_state, p_node_index);
 			} else {
 				current_node = _generate_spatial(p_state, p_node_index);
@@ -2272,13 +3972,13 @@ void FBXDocument::_generate_skeleton_bone_node(Ref<FBXState> p_state, const FBXN
 			current_node->propagate_call(StringName("set_owner"), args);
 		}
 		// Do not set transform here. Transform is already applied to our bone.
-		current_node->set_name(fbx_node->get_name());
+		current_node->set_name(table.names[p_node_index]);
 	}
 
 	p_state->scene_nodes.insert(p_node_index, current_node);
 
-	for (int i = 0; i < fbx_node->children.size(); ++i) {
-		_generate_scene_node(p_state, fbx_node->children[i], active_skeleton, p_scene_root);
+	for (const FBXNodeIndex child_i : table.get_children(p_node_index)) {
+		_generate_scene_node(p_state, child_i, active_skeleton, p_scene_root);
 	}
 }
 
@@ -2324,15 +4024,130 @@ struct SceneFormatImporterGLTFInterpolate<Quaternion> {
 		return p1.slerp(p2, c).normalized();
 	}
 
-	Quaternion bezier(const Quaternion start, const Quaternion control_1, const Quaternion control_2, const Quaternion end, const float t) {
-		ERR_FAIL_COND_V_MSG(!start.is_normalized(), Quaternion(), "The start quaternion must be normalized.");
-		ERR_FAIL_COND_V_MSG(!end.is_normalized(), Quaternion(), "The end quaternion must be normalized.");
+	Quaternion bezier(const Quaternion start, const Quaternion control_1, const Quaternion control_2, const Quaternion end, const float t) {
+		ERR_FAIL_COND_V_MSG(!start.is_normalized(), Quaternion(), "The start quaternion must be normalized.");
+		ERR_FAIL_COND_V_MSG(!end.is_normalized(), Quaternion(), "The end quaternion must be normalized.");
+
+		return start.slerp(end, t).normalized();
+	}
+};
+
+// Baked keys are already sorted, so instead of a sorted insert per key the whole track is
+// written at once through the same flat `tracks/<i>/keys` layout Animation is saved with:
+// time, transition, then the value components of every key.
+static void _store_track_key_value(real_t *r_key, const Vector3 &p_value) {
+	r_key[0] = p_value.x;
+	r_key[1] = p_value.y;
+	r_key[2] = p_value.z;
+}
+
+static void _store_track_key_value(real_t *r_key, const Quaternion &p_value) {
+	r_key[0] = p_value.x;
+	r_key[1] = p_value.y;
+	r_key[2] = p_value.z;
+	r_key[3] = p_value.w;
+}
+
+static void _store_track_key_value(real_t *r_key, real_t p_value) {
+	r_key[0] = p_value;
+}
+
+// Stepped curves are baked as two keys a `nextafter()` apart, which end up at the same float
+// time. Like `Animation::_insert()`, only the last key at a given time is kept.
+template <class T>
+static void _set_track_keys(Ref<Animation> p_animation, int p_track, const FBXAnimation::Channel<T> &p_channel, double p_time_offset) {
+	const int stride = 2 + (sizeof(T) / sizeof(real_t));
+	const int key_count = p_channel.times.size();
+	ERR_FAIL_COND(p_channel.values.size() < key_count);
+	const real_t *times = p_channel.times.ptr();
+	const T *values = p_channel.values.ptr();
+
+	Vector<real_t> keys;
+	keys.resize(key_count * stride);
+	real_t *w = keys.ptrw();
+	int track_key_count = 0;
+	for (int key_i = 0; key_i < key_count; key_i++) {
+		const float time = float(times[key_i] - p_time_offset);
+		if (key_i + 1 < key_count && Math::is_equal_approx(time, float(times[key_i + 1] - p_time_offset))) {
+			continue;
+		}
+		ERR_FAIL_COND_MSG(track_key_count > 0 && time <= w[(track_key_count - 1) * stride], vformat("Animation key times of track %d aren't strictly increasing.", p_track));
+		real_t *key = w + track_key_count * stride;
+		key[0] = time;
+		key[1] = 1.0; // Transition.
+		_store_track_key_value(key + 2, values[key_i]);
+		track_key_count++;
+	}
+	keys.resize(track_key_count * stride);
+
+	bool valid = false;
+	p_animation->set(vformat("tracks/%d/keys", p_track), keys, &valid);
+	ERR_FAIL_COND_MSG(!valid || p_animation->track_get_key_count(p_track) != track_key_count, vformat("Animation track %d rejected its %d packed keys.", p_track, track_key_count));
+}
+
+void FBXDocument::_build_animation_targets(Ref<FBXState> p_state, Node *p_root, AnimationTargetTable &r_targets) {
+	const FBXNodeTable &table = p_state->node_table;
+	r_targets.nodes.resize(table.size());
+	r_targets.blend_shapes.clear();
+
+	for (FBXNodeIndex node_index = 0; node_index < table.size(); node_index++) {
+		AnimationNodeTarget &target = r_targets.nodes.write[node_index];
+
+		HashMap<FBXNodeIndex, Node *>::Iterator node_element = p_state->scene_nodes.find(node_index);
+		if (!node_element) {
+			continue;
+		}
+		//need to find the path: for skeletons, weight tracks will affect the mesh
+		const NodePath node_path = p_root->get_path_to(node_element->value);
+
+		//for skeletons, transform tracks always affect bones
+		if (table.skeletons[node_index] >= 0) {
+			const Skeleton3D *sk = p_state->skeletons[table.skeletons[node_index]]->godot_skeleton;
+			ERR_CONTINUE_MSG(!sk, vformat("Unable to find skeleton for node %d.", node_index));
+
+			const String path = p_root->get_path_to(sk);
+			const String bone = table.names[node_index];
+			target.transform_path = path + ":" + bone;
+		} else {
+			target.transform_path = node_path;
+		}
+		target.valid = true;
+
+		// Animated TRS properties will not affect a skinned mesh.
+		target.animates_transform = !(table.skeletons[node_index] < 0 && table.skins[node_index] >= 0);
+		target.rest_position = table.positions[node_index];
+		target.rest_rotation = table.rotations[node_index].normalized();
+		target.rest_scale = table.scales[node_index];
+
+		if (table.meshes[node_index] < 0) {
+			continue;
+		}
+
+		// For meshes, especially skinned meshes, there are cases where it will be added as a child.
+		NodePath mesh_instance_node_path;
+		HashMap<FBXNodeIndex, ImporterMeshInstance3D *>::Iterator mesh_instance_element = p_state->scene_mesh_instances.find(node_index);
+		if (mesh_instance_element) {
+			mesh_instance_node_path = p_root->get_path_to(mesh_instance_element->value);
+		} else {
+			mesh_instance_node_path = node_path;
+		}
+
+		Ref<FBXMesh> mesh = p_state->meshes[table.meshes[node_index]];
+		ERR_CONTINUE(mesh.is_null());
+		ERR_CONTINUE(mesh->get_mesh().is_null());
+		ERR_CONTINUE(mesh->get_mesh()->get_mesh().is_null());
 
-		return start.slerp(end, t).normalized();
+		Vector<int> blend_channels = mesh->get_blend_channels();
+		for (int i = 0; i < blend_channels.size(); i++) {
+			AnimationBlendTarget blend_target;
+			blend_target.blend_channel = blend_channels[i];
+			blend_target.path = String(mesh_instance_node_path) + ":" + String(mesh->get_mesh()->get_blend_shape_name(i));
+			r_targets.blend_shapes.push_back(blend_target);
+		}
 	}
-};
+}
 
-void FBXDocument::_import_animation(Ref<FBXState> p_state, AnimationPlayer *p_animation_player, const FBXAnimationIndex p_index, const float p_bake_fps, const bool p_trimming, const bool p_remove_immutable_tracks) {
+void FBXDocument::_import_animation(Ref<FBXState> p_state, AnimationPlayer *p_animation_player, const FBXAnimationIndex p_index, const AnimationTargetTable &p_targets, const float p_bake_fps, const bool p_trimming, const bool p_remove_immutable_tracks) {
 	Ref<FBXAnimation> anim = p_state->animations[p_index];
 
 	String anim_name = anim->get_name();
@@ -2353,33 +4168,12 @@ void FBXDocument::_import_animation(Ref<FBXState> p_state, AnimationPlayer *p_an
 
 	for (const KeyValue<int, FBXAnimation::Track> &track_i : anim->get_tracks()) {
 		const FBXAnimation::Track &track = track_i.value;
-		//need to find the path: for skeletons, weight tracks will affect the mesh
-		NodePath node_path;
-		//for skeletons, transform tracks always affect bones
-		NodePath transform_node_path;
-		FBXNodeIndex node_index = track_i.key;
-		Node *root = p_animation_player->get_parent();
-		ERR_FAIL_NULL(root);
-		HashMap<FBXNodeIndex, Node *>::Iterator node_element = p_state->scene_nodes.find(node_index);
-		ERR_CONTINUE_MSG(!node_element, vformat("Unable to find node %d for animation.", node_index));
-		node_path = root->get_path_to(node_element->value);
-
-		const Ref<FBXNode> fbx_node = p_state->nodes[track_i.key];
-
-		if (fbx_node->skeleton >= 0) {
-			const Skeleton3D *sk = p_state->skeletons[fbx_node->skeleton]->godot_skeleton;
-			ERR_FAIL_NULL(sk);
-
-			const String path = p_animation_player->get_parent()->get_path_to(sk);
-			const String bone = fbx_node->get_name();
-			transform_node_path = path + ":" + bone;
-		} else {
-			transform_node_path = node_path;
-		}
+		const FBXNodeIndex node_index = track_i.key;
+		ERR_CONTINUE(node_index < 0 || node_index >= p_targets.nodes.size());
+		const AnimationNodeTarget &target = p_targets.nodes[node_index];
+		ERR_CONTINUE_MSG(!target.valid, vformat("Unable to find node %d for animation.", node_index));
 
-		// Animated TRS properties will not affect a skinned mesh.
-		const bool transform_affects_skinned_mesh_instance = fbx_node->skeleton < 0 && fbx_node->skin >= 0;
-		if ((track.rotation_track.values.size() || track.position_track.values.size() || track.scale_track.values.size()) && !transform_affects_skinned_mesh_instance) {
+		if ((track.rotation_track.values.size() || track.position_track.values.size() || track.scale_track.values.size()) && target.animates_transform) {
 			// Make a transform track.
 			int base_idx = animation->get_track_count();
 			int position_idx = -1;
@@ -2389,10 +4183,9 @@ void FBXDocument::_import_animation(Ref<FBXState> p_state, AnimationPlayer *p_an
 			if (track.position_track.values.size()) {
 				bool is_default = true; // Discard the track if all it contains is default values.
 				if (p_remove_immutable_tracks) {
-					Vector3 base_pos = p_state->nodes[track_i.key]->position;
 					for (int i = 0; i < track.position_track.times.size(); i++) {
 						Vector3 value = track.position_track.values[track.position_track.interpolation == FBXAnimation::INTERP_CUBIC_SPLINE ? (1 + i * 3) : i];
-						if (!value.is_equal_approx(base_pos)) {
+						if (!value.is_equal_approx(target.rest_position)) {
 							is_default = false;
 							break;
 						}
@@ -2401,7 +4194,7 @@ void FBXDocument::_import_animation(Ref<FBXState> p_state, AnimationPlayer *p_an
 				if (!p_remove_immutable_tracks || !is_default) {
 					position_idx = base_idx;
 					animation->add_track(Animation::TYPE_POSITION_3D);
-					animation->track_set_path(position_idx, transform_node_path);
+					animation->track_set_path(position_idx, target.transform_path);
 					animation->track_set_imported(position_idx, true); // Helps merging positions later.
 					base_idx++;
 				}
@@ -2409,10 +4202,9 @@ void FBXDocument::_import_animation(Ref<FBXState> p_state, AnimationPlayer *p_an
 			if (track.rotation_track.values.size()) {
 				bool is_default = true; // Discard the track if all the track contains is the default values.
 				if (p_remove_immutable_tracks) {
-					Quaternion base_rot = p_state->nodes[track_i.key]->rotation.normalized();
 					for (int i = 0; i < track.rotation_track.times.size(); i++) {
 						Quaternion value = track.rotation_track.values[track.rotation_track.interpolation == FBXAnimation::INTERP_CUBIC_SPLINE ? (1 + i * 3) : i].normalized();
-						if (!value.is_equal_approx(base_rot)) {
+						if (!value.is_equal_approx(target.rest_rotation)) {
 							is_default = false;
 							break;
 						}
@@ -2421,7 +4213,7 @@ void FBXDocument::_import_animation(Ref<FBXState> p_state, AnimationPlayer *p_an
 				if (!p_remove_immutable_tracks || !is_default) {
 					rotation_idx = base_idx;
 					animation->add_track(Animation::TYPE_ROTATION_3D);
-					animation->track_set_path(rotation_idx, transform_node_path);
+					animation->track_set_path(rotation_idx, target.transform_path);
 					animation->track_set_imported(rotation_idx, true); //helps merging later
 					base_idx++;
 				}
@@ -2429,10 +4221,9 @@ void FBXDocument::_import_animation(Ref<FBXState> p_state, AnimationPlayer *p_an
 			if (track.scale_track.values.size()) {
 				bool is_default = true; // Discard the track if all the track contains is the default values.
 				if (p_remove_immutable_tracks) {
-					Vector3 base_scale = p_state->nodes[track_i.key]->scale;
 					for (int i = 0; i < track.scale_track.times.size(); i++) {
 						Vector3 value = track.scale_track.values[track.scale_track.interpolation == FBXAnimation::INTERP_CUBIC_SPLINE ? (1 + i * 3) : i];
-						if (!value.is_equal_approx(base_scale)) {
+						if (!value.is_equal_approx(target.rest_scale)) {
 							is_default = false;
 							break;
 						}
@@ -2441,7 +4232,7 @@ void FBXDocument::_import_animation(Ref<FBXState> p_state, AnimationPlayer *p_an
 				if (!p_remove_immutable_tracks || !is_default) {
 					scale_idx = base_idx;
 					animation->add_track(Animation::TYPE_SCALE_3D);
-					animation->track_set_path(scale_idx, transform_node_path);
+					animation->track_set_path(scale_idx, target.transform_path);
 					animation->track_set_imported(scale_idx, true); //helps merging later
 					base_idx++;
 				}
@@ -2449,82 +4240,42 @@ void FBXDocument::_import_animation(Ref<FBXState> p_state, AnimationPlayer *p_an
 
 			if (position_idx != -1) {
 				animation->track_set_interpolation_type(position_idx, Animation::INTERPOLATION_LINEAR);
-				for (int j = 0; j < track.position_track.times.size(); j++) {
-					const float t = track.position_track.times[j] - anim_start_offset;
-					const Vector3 value = track.position_track.values[j];
-					animation->position_track_insert_key(position_idx, t, value);
-				}
+				_set_track_keys(animation, position_idx, track.position_track, anim_start_offset);
 			}
 
 			if (rotation_idx != -1) {
 				animation->track_set_interpolation_type(rotation_idx, Animation::INTERPOLATION_LINEAR);
-				for (int j = 0; j < track.rotation_track.times.size(); j++) {
-					const float t = track.rotation_track.times[j] - anim_start_offset;
-					const Quaternion value = track.rotation_track.values[j];
-					animation->rotation_track_insert_key(rotation_idx, t, value);
-				}
+				_set_track_keys(animation, rotation_idx, track.rotation_track, anim_start_offset);
 			}
 
 			if (scale_idx != -1) {
 				animation->track_set_interpolation_type(scale_idx, Animation::INTERPOLATION_LINEAR);
-				for (int j = 0; j < track.scale_track.times.size(); j++) {
-					const float t = track.scale_track.times[j] - anim_start_offset;
-					const Vector3 value = track.scale_track.values[j];
-					animation->scale_track_insert_key(scale_idx, t, value);
-				}
+				_set_track_keys(animation, scale_idx, track.scale_track, anim_start_offset);
 			}
 		}
 	}
 
-	for (FBXNodeIndex node_index = 0; node_index < p_state->nodes.size(); node_index++) {
-		Ref<FBXNode> node = p_state->nodes[node_index];
-		if (node->mesh < 0) {
-			continue;
-		}
-
-		// For meshes, especially skinned meshes, there are cases where it will be added as a child.
-		NodePath mesh_instance_node_path;
-
-		Node *root = p_animation_player->get_parent();
-		ERR_FAIL_NULL(root);
-		HashMap<FBXNodeIndex, Node *>::Iterator node_element = p_state->scene_nodes.find(node_index);
-		ERR_CONTINUE_MSG(!node_element, vformat("Unable to find node %d for animation.", node_index));
-		NodePath node_path = root->get_path_to(node_element->value);
-		HashMap<FBXNodeIndex, ImporterMeshInstance3D *>::Iterator mesh_instance_element = p_state->scene_mesh_instances.find(node_index);
-		if (mesh_instance_element) {
-			mesh_instance_node_path = root->get_path_to(mesh_instance_element->value);
-		} else {
-			mesh_instance_node_path = node_path;
-		}
-
-		Ref<FBXMesh> mesh = p_state->meshes[node->mesh];
-		ERR_CONTINUE(mesh.is_null());
-		ERR_CONTINUE(mesh->get_mesh().is_null());
-		ERR_CONTINUE(mesh->get_mesh()->get_mesh().is_null());
+	for (const AnimationBlendTarget &blend_target : p_targets.blend_shapes) {
+		const FBXAnimation::BlendShapeTrack *blend_track = anim->get_blend_tracks().getptr(blend_target.blend_channel);
+		if (blend_track) {
+			const int track_idx = animation->get_track_count();
+			animation->add_track(Animation::TYPE_BLEND_SHAPE);
+			animation->track_set_path(track_idx, blend_target.path);
+			animation->track_set_imported(track_idx, true); // Helps merging later.
 
-		Vector<int> blend_channels = mesh->get_blend_channels();
-		for (int i = 0; i < blend_channels.size(); i++) {
-			FBXAnimation::BlendShapeTrack *blend_track = anim->get_blend_tracks().getptr(blend_channels[i]);
-			if (blend_track) {
-				const String blend_path = String(mesh_instance_node_path) + ":" + String(mesh->get_mesh()->get_blend_shape_name(i));
-
-				const int track_idx = animation->get_track_count();
-				animation->add_track(Animation::TYPE_BLEND_SHAPE);
-				animation->track_set_path(track_idx, blend_path);
-				animation->track_set_imported(track_idx, true); // Helps merging later.
-
-				animation->track_set_interpolation_type(track_idx, Animation::INTERPOLATION_LINEAR);
-				for (int j = 0; j < blend_track->weight_track.times.size(); j++) {
-					const float t = blend_track->weight_track.times[j] - anim_start_offset;
-					const float attribs = blend_track->weight_track.values[j];
-					animation->blend_shape_track_insert_key(track_idx, t, attribs);
-				}
-			}
+			animation->track_set_interpolation_type(track_idx, Animation::INTERPOLATION_LINEAR);
+			_set_track_keys(animation, track_idx, blend_track->weight_track, anim_start_offset);
 		}
 	}
 
 	animation->set_length(anim->get_time_end() - anim->get_time_begin());
 
+	if (p_state->compress_animations) {
+		// There is no public way to write compressed pages directly, but compressing here
+		// releases the float keys of each take before the next one is built.
+		animation->compress(uint32_t(p_state->animation_compression_page_size) * 1024, uint32_t(MAX(Math::ceil(p_bake_fps), 1.0f)));
+	}
+
 	Ref<AnimationLibrary> library;
 	if (!p_animation_player->has_animation_library("")) {
 		library.instantiate();
@@ -2536,11 +4287,10 @@ void FBXDocument::_import_animation(Ref<FBXState> p_state, AnimationPlayer *p_an
 }
 
 void FBXDocument::_process_mesh_instances(Ref<FBXState> p_state, Node *p_scene_root) {
-	for (FBXNodeIndex node_i = 0; node_i < p_state->nodes.size(); ++node_i) {
-		Ref<FBXNode> node = p_state->nodes[node_i];
-
-		if (node->skin >= 0 && node->mesh >= 0) {
-			const FBXSkinIndex skin_i = node->skin;
+	const FBXNodeTable &table = p_state->node_table;
+	for (FBXNodeIndex node_i = 0; node_i < table.size(); ++node_i) {
+		if (table.skins[node_i] >= 0 && table.meshes[node_i] >= 0) {
+			const FBXSkinIndex skin_i = table.skins[node_i];
 
 			ImporterMeshInstance3D *mi = nullptr;
 			HashMap<FBXNodeIndex, ImporterMeshInstance3D *>::Iterator mi_element = p_state->scene_mesh_instances.find(node_i);
@@ -2553,7 +4303,7 @@ void FBXDocument::_process_mesh_instances(Ref<FBXState> p_state, Node *p_scene_r
 				ERR_CONTINUE_MSG(mi == nullptr, vformat("Unable to cast node %d of type %s to ImporterMeshInstance3D", node_i, si_element->value->get_class_name()));
 			}
 
-			const FBXSkeletonIndex skel_i = p_state->skins.write[node->skin]->skeleton;
+			const FBXSkeletonIndex skel_i = p_state->skins.write[table.skins[node_i]]->skeleton;
 			Ref<FBXSkeleton> fbx_skeleton = p_state->skeletons.write[skel_i];
 			Skeleton3D *skeleton = fbx_skeleton->godot_skeleton;
 			ERR_CONTINUE_MSG(skeleton == nullptr, vformat("Unable to find Skeleton for node %d skin %d", node_i, skin_i));
@@ -2569,50 +4319,128 @@ void FBXDocument::_process_mesh_instances(Ref<FBXState> p_state, Node *p_scene_r
 	}
 }
 
+void FBXDocument::_setup_load_opts(Ref<FBXState> p_state, ufbx_load_opts &r_opts, FBXArenaAllocator *p_temp_arena) {
+	r_opts.temp_allocator.allocator.alloc_fn = &FBXArenaAllocator::alloc_fn;
+	r_opts.temp_allocator.allocator.realloc_fn = &FBXArenaAllocator::realloc_fn;
+	r_opts.temp_allocator.allocator.free_fn = &FBXArenaAllocator::free_fn;
+	r_opts.temp_allocator.allocator.user = p_temp_arena;
+	r_opts.temp_allocator.memory_limit = size_t(p_state->memory_limit);
+	r_opts.temp_allocator.allocation_limit = size_t(p_state->allocation_limit);
+
+	// Fewer, larger result chunks, the scene is freed as a whole anyway.
+	r_opts.result_allocator.allocator.alloc_fn = &_result_alloc_fn;
+	r_opts.result_allocator.allocator.realloc_fn = &_result_realloc_fn;
+	r_opts.result_allocator.allocator.free_fn = &_result_free_fn;
+	r_opts.result_allocator.memory_limit = size_t(p_state->memory_limit);
+	r_opts.result_allocator.allocation_limit = size_t(p_state->allocation_limit);
+	r_opts.result_allocator.huge_threshold = 4 << 20;
+	r_opts.result_allocator.max_chunk_size = 64 << 20;
+
+	r_opts.target_axes = ufbx_axes_right_handed_y_up;
+	r_opts.target_unit_meters = 1.0f;
+	r_opts.space_conversion = UFBX_SPACE_CONVERSION_MODIFY_GEOMETRY;
+	r_opts.geometry_transform_handling = UFBX_GEOMETRY_TRANSFORM_HANDLING_HELPER_NODES;
+	r_opts.inherit_mode_handling = UFBX_INHERIT_MODE_HANDLING_COMPENSATE;
+	r_opts.geometry_transform_helper_name.data = "_GeometryTransformHelper";
+	r_opts.geometry_transform_helper_name.length = SIZE_MAX;
+	r_opts.scale_helper_name.data = "_ScaleHelper";
+	r_opts.scale_helper_name.length = SIZE_MAX;
+	r_opts.target_camera_axes = ufbx_axes_right_handed_y_up;
+	r_opts.target_light_axes = ufbx_axes_right_handed_y_up;
+	r_opts.clean_skin_weights = true;
+	if (p_state->discard_meshes_and_materials) {
+		r_opts.ignore_geometry = true;
+		r_opts.ignore_embedded = true;
+	}
+	if (!p_state->import_animations) {
+		r_opts.ignore_animation = true;
+	}
+	r_opts.generate_missing_normals = true;
+	r_opts.progress_cb.fn = &FBXDocument::_load_progress_fn;
+	r_opts.progress_cb.user = this;
+	r_opts.progress_interval_hint = 1 << 20;
+}
+
+Error FBXDocument::_parse_loaded_scene(Ref<FBXState> p_state, String p_path, const ufbx_error &p_error) {
+	if (p_error.type == UFBX_ERROR_CANCELLED) {
+		return ERR_SKIP;
+	}
+	if (!p_state->scene.get()) {
+		char err_buf[512];
+		ufbx_format_error(err_buf, sizeof(err_buf), &p_error);
+		ERR_FAIL_V_MSG(ERR_PARSE_ERROR, err_buf);
+	}
+
+	Error err = _parse_fbx_state(p_state, p_path);
+	ERR_FAIL_COND_V(err != OK, err);
+
+	return OK;
+}
+
 Error FBXDocument::_parse(Ref<FBXState> p_state, String p_path, Ref<FileAccess> p_file) {
 	p_state->scene.reset();
 
-	Error err = ERR_INVALID_DATA;
 	if (p_file.is_null()) {
 		return FAILED;
 	}
 
+	// Released together with all temporary allocations once the load is done.
+	FBXArenaAllocator temp_arena;
 	ufbx_load_opts opts = {};
-	opts.target_axes = ufbx_axes_right_handed_y_up;
-	opts.target_unit_meters = 1.0f;
-	opts.space_conversion = UFBX_SPACE_CONVERSION_MODIFY_GEOMETRY;
-	opts.geometry_transform_handling = UFBX_GEOMETRY_TRANSFORM_HANDLING_HELPER_NODES;
-	opts.inherit_mode_handling = UFBX_INHERIT_MODE_HANDLING_COMPENSATE;
-	opts.geometry_transform_helper_name.data = "_GeometryTransformHelper";
-	opts.geometry_transform_helper_name.length = SIZE_MAX;
-	opts.scale_helper_name.data = "_ScaleHelper";
-	opts.scale_helper_name.length = SIZE_MAX;
-	opts.target_camera_axes = ufbx_axes_right_handed_y_up;
-	opts.target_light_axes = ufbx_axes_right_handed_y_up;
-	opts.clean_skin_weights = true;
-	if (p_state->discard_meshes_and_materials) {
-		opts.ignore_geometry = true;
-		opts.ignore_embedded = true;
-	}
-	opts.generate_missing_normals = true;
+	_setup_load_opts(p_state, opts, &temp_arena);
 
 	ufbx_error error;
-	ufbx_stream file_stream = {};
-	file_stream.read_fn = &_file_access_read_fn;
-	file_stream.skip_fn = &_file_access_skip_fn;
-	file_stream.user = p_file.ptr();
-	p_state->scene.reset(ufbx_load_stream(&file_stream, &opts, &error));
-
-	if (!p_state->scene.get()) {
-		char err_buf[512];
-		ufbx_format_error(err_buf, sizeof(err_buf), &error);
-		ERR_FAIL_V_MSG(ERR_PARSE_ERROR, err_buf);
+	{
+		FBXProfileScope profile(p_state.ptr(), "ufbx_load");
+		FBXMappedFile mapped_file;
+		p_state->source_hash = String();
+		p_state->source_path = p_file->get_path_absolute();
+		if (mapped_file.open(p_file->get_path_absolute())) {
+			if (!p_state->cache_path.is_empty() && mapped_file.size <= size_t(INT32_MAX)) {
+				p_state->source_hash = _md5_text(mapped_file.data, mapped_file.size);
+			}
+			p_state->scene.reset(ufbx_load_memory(mapped_file.data, mapped_file.size, &opts, &error));
+		} else {
+			if (!p_state->cache_path.is_empty()) {
+				p_state->source_hash = FileAccess::get_md5(p_file->get_path());
+			}
+			ufbx_stream file_stream = {};
+			file_stream.read_fn = &_file_access_read_fn;
+			file_stream.skip_fn = &_file_access_skip_fn;
+			file_stream.user = p_file.ptr();
+			opts.file_size_estimate = p_file->get_length();
+			p_state->scene.reset(ufbx_load_stream(&file_stream, &opts, &error));
+		}
+		if (p_state->scene.get()) {
+			profile.set_count(int64_t(p_state->scene->elements.count));
+			profile.set_allocation_count(int64_t(p_state->scene->metadata.temp_allocs + p_state->scene->metadata.result_allocs));
+		}
 	}
 
-	err = _parse_fbx_state(p_state, p_path);
-	ERR_FAIL_COND_V(err != OK, err);
+	return _parse_loaded_scene(p_state, p_path, error);
+}
 
-	return OK;
+Error FBXDocument::_parse_buffer(Ref<FBXState> p_state, String p_path, const PackedByteArray &p_bytes) {
+	p_state->scene.reset();
+
+	// Released together with all temporary allocations once the load is done.
+	FBXArenaAllocator temp_arena;
+	ufbx_load_opts opts = {};
+	_setup_load_opts(p_state, opts, &temp_arena);
+
+	ufbx_error error;
+	{
+		FBXProfileScope profile(p_state.ptr(), "ufbx_load");
+		p_state->source_path = String();
+		p_state->source_hash = p_state->cache_path.is_empty() ? String() : _md5_text(p_bytes.ptr(), size_t(p_bytes.size()));
+		p_state->scene.reset(ufbx_load_memory(p_bytes.ptr(), size_t(p_bytes.size()), &opts, &error));
+		if (p_state->scene.get()) {
+			profile.set_count(int64_t(p_state->scene->elements.count));
+			profile.set_allocation_count(int64_t(p_state->scene->metadata.temp_allocs + p_state->scene->metadata.result_allocs));
+		}
+	}
+
+	return _parse_loaded_scene(p_state, p_path, error);
 }
 
 void FBXDocument::_bind_methods() {
@@ -2620,31 +4448,244 @@ void FBXDocument::_bind_methods() {
 			&FBXDocument::append_from_file, DEFVAL(0), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("append_from_buffer", "bytes", "base_path", "state", "flags"),
 			&FBXDocument::append_from_buffer, DEFVAL(0));
+	ClassDB::bind_method(D_METHOD("append_from_files", "paths", "states", "flags", "base_path"),
+			&FBXDocument::append_from_files, DEFVAL(0), DEFVAL(String()));
 	ClassDB::bind_method(D_METHOD("generate_scene", "state", "bake_fps", "trimming", "remove_immutable_tracks"),
 			&FBXDocument::generate_scene, DEFVAL(30), DEFVAL(false), DEFVAL(true));
 	ClassDB::bind_static_method("FBXDocument", D_METHOD("register_fbx_document_extension", "extension", "first_priority"),
 			&FBXDocument::register_fbx_document_extension, DEFVAL(false));
 	ClassDB::bind_static_method("FBXDocument", D_METHOD("unregister_fbx_document_extension", "extension"),
 			&FBXDocument::unregister_fbx_document_extension);
+	ClassDB::bind_method(D_METHOD("set_progress_callback", "callback"), &FBXDocument::set_progress_callback);
+	ClassDB::bind_method(D_METHOD("get_progress_callback"), &FBXDocument::get_progress_callback);
+	ClassDB::bind_method(D_METHOD("cancel"), &FBXDocument::cancel);
+	ClassDB::bind_method(D_METHOD("is_cancel_requested"), &FBXDocument::is_cancel_requested);
+	ClassDB::bind_method(D_METHOD("append_from_file_async", "path", "state", "flags", "base_path"),
+			&FBXDocument::append_from_file_async, DEFVAL(0), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("generate_scene_async", "state", "bake_fps", "trimming", "remove_immutable_tracks"),
+			&FBXDocument::generate_scene_async, DEFVAL(30), DEFVAL(false), DEFVAL(true));
+	ClassDB::bind_method(D_METHOD("is_async_task_running"), &FBXDocument::is_async_task_running);
+	ClassDB::bind_method(D_METHOD("get_async_progress"), &FBXDocument::get_async_progress);
+	ClassDB::bind_method(D_METHOD("wait_for_async_task"), &FBXDocument::wait_for_async_task);
+
+	ADD_SIGNAL(MethodInfo("append_completed", PropertyInfo(Variant::INT, "error")));
+	ADD_SIGNAL(MethodInfo("scene_generated", PropertyInfo(Variant::OBJECT, "root", PROPERTY_HINT_RESOURCE_TYPE, "Node")));
+}
+
+struct FBXProgressStageInfo {
+	const char *name;
+	float begin;
+	float end;
+};
+
+// Rough share of the total import time spent in each stage, used to map stage progress to overall progress.
+static const FBXProgressStageInfo _progress_stages[] = {
+	{ "Loading", 0.0f, 0.3f },
+	{ "Parsing nodes", 0.3f, 0.35f },
+	{ "Parsing images", 0.35f, 0.5f },
+	{ "Parsing materials", 0.5f, 0.52f },
+	{ "Parsing skins", 0.52f, 0.57f },
+	{ "Parsing meshes", 0.57f, 0.75f },
+	{ "Parsing animations", 0.75f, 0.87f },
+	{ "Creating scene", 0.87f, 0.9f },
+	{ "Importing animations", 0.9f, 1.0f },
+};
+
+bool FBXDocument::_report_progress(ProgressStage p_stage, float p_stage_progress) {
+	static_assert(sizeof(_progress_stages) / sizeof(_progress_stages[0]) == PROGRESS_STAGE_MAX);
+	if (async_reporting) {
+		// Asynchronous tasks never call back into scripts from the worker thread.
+		const FBXProgressStageInfo &stage = _progress_stages[p_stage];
+		const float progress = Math::lerp(stage.begin, stage.end, CLAMP(p_stage_progress, 0.0f, 1.0f));
+		{
+			MutexLock lock(async_mutex);
+			async_progress = progress;
+		}
+		if (progress_callback.is_valid()) {
+			progress_callback.call_deferred(String(stage.name), progress);
+		}
+	} else if (progress_callback.is_valid()) {
+		const FBXProgressStageInfo &stage = _progress_stages[p_stage];
+		const float progress = Math::lerp(stage.begin, stage.end, CLAMP(p_stage_progress, 0.0f, 1.0f));
+		Variant ret = progress_callback.call(String(stage.name), progress);
+		// Returning `false` from the callback cancels the import, any other value continues.
+		if (ret.get_type() == Variant::BOOL && !bool(ret)) {
+			cancel_requested.set();
+		}
+	}
+	if (batch && batch->owner->cancel_requested.is_set()) {
+		return false;
+	}
+	return !cancel_requested.is_set();
+}
+
+// Waits for a group task of a parse stage, reporting progress whenever the workers finish
+// another element. A cancel seen by `_report_progress()`, also one of the whole batch, is passed
+// on to `cancel_requested` so the workers skip the elements they haven't started yet.
+void FBXDocument::_wait_for_group_task(WorkerThreadPool::GroupID p_group_id, ProgressStage p_stage, const SafeNumeric<uint32_t> &p_completed, uint32_t p_count) {
+	uint32_t reported = UINT32_MAX;
+	while (!WorkerThreadPool::get_singleton()->is_group_task_completed(p_group_id)) {
+		const uint32_t completed = p_completed.get();
+		bool proceed;
+		if (completed != reported) {
+			reported = completed;
+			proceed = _report_progress(p_stage, float(completed) / float(MAX(p_count, 1u)));
+		} else {
+			proceed = !cancel_requested.is_set() && !(batch && batch->owner->cancel_requested.is_set());
+		}
+		if (!proceed) {
+			cancel_requested.set();
+		}
+		OS::get_singleton()->delay_usec(1000);
+	}
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(p_group_id);
+}
+
+ufbx_progress_result FBXDocument::_load_progress_fn(void *p_user, const ufbx_progress *p_progress) {
+	FBXDocument *doc = static_cast<FBXDocument *>(p_user);
+	const float progress = p_progress->bytes_total > 0 ? float(double(p_progress->bytes_read) / double(p_progress->bytes_total)) : 0.0f;
+	return doc->_report_progress(PROGRESS_STAGE_LOAD, progress) ? UFBX_PROGRESS_CONTINUE : UFBX_PROGRESS_CANCEL;
+}
+
+void FBXDocument::set_progress_callback(const Callable &p_callback) {
+	progress_callback = p_callback;
+}
+
+Callable FBXDocument::get_progress_callback() const {
+	return progress_callback;
+}
+
+Error FBXDocument::append_from_file_async(String p_path, Ref<FBXState> p_state, uint32_t p_flags, String p_base_path) {
+	ERR_FAIL_COND_V_MSG(is_async_task_running(), ERR_BUSY, "FBX: An asynchronous task is already running on this document.");
+	ERR_FAIL_COND_V(p_path.is_empty(), ERR_FILE_NOT_FOUND);
+	ERR_FAIL_NULL_V(p_state, ERR_INVALID_PARAMETER);
+	async_task = AsyncTask();
+	async_task.state = p_state;
+	async_task.path = p_path;
+	async_task.base_path = p_base_path;
+	async_task.flags = p_flags;
+	// Extracted textures are written and imported on the main thread, like in a batch.
+	async_batch.owner = this;
+	async_batch.thread_id = Thread::get_main_id();
+	async_batch.deferred_image_extracts = true;
+	batch = &async_batch;
+	return _start_async_task();
+}
+
+Error FBXDocument::generate_scene_async(Ref<FBXState> p_state, float p_bake_fps, bool p_trimming, bool p_remove_immutable_tracks) {
+	ERR_FAIL_COND_V_MSG(is_async_task_running(), ERR_BUSY, "FBX: An asynchronous task is already running on this document.");
+	ERR_FAIL_NULL_V(p_state, ERR_INVALID_PARAMETER);
+	async_task = AsyncTask();
+	async_task.state = p_state;
+	async_task.generate = true;
+	async_task.bake_fps = p_bake_fps;
+	async_task.trimming = p_trimming;
+	async_task.remove_immutable_tracks = p_remove_immutable_tracks;
+	return _start_async_task();
+}
+
+Error FBXDocument::_start_async_task() {
+	async_task.document = Ref<FBXDocument>(this);
+	async_task.serial = ++async_serial;
+	async_progress = 0.0f;
+	async_reporting = true;
+	cancel_requested.clear();
+	// Low priority, so the group tasks of the parse stages still have threads to run on.
+	async_task_id = WorkerThreadPool::get_singleton()->add_template_task(this, &FBXDocument::_run_async_task, &async_task, false, SNAME("FBXAsyncImport"));
+	return OK;
+}
+
+void FBXDocument::_run_async_task(AsyncTask *p_task) {
+	// Nodes outside of the scene tree can be built on any thread.
+	if (p_task->generate) {
+		p_task->root = generate_scene(p_task->state, p_task->bake_fps, p_task->trimming, p_task->remove_immutable_tracks);
+		p_task->error = p_task->root ? OK : FAILED;
+	} else {
+		p_task->error = _append_from_file(p_task->path, p_task->state, p_task->flags, p_task->base_path);
+	}
+	callable_mp(this, &FBXDocument::_finish_async_task_deferred).call_deferred(p_task->serial);
+}
+
+void FBXDocument::_finish_async_task_deferred(uint32_t p_serial) {
+	// A task finished by `wait_for_async_task()` leaves its deferred call behind, which must not
+	// finish a task started after it.
+	if (p_serial != async_serial) {
+		return;
+	}
+	_finish_async_task();
+}
+
+void FBXDocument::_finish_async_task() {
+	if (async_task_id == WorkerThreadPool::INVALID_TASK_ID) {
+		return; // Already finished by `wait_for_async_task()`.
+	}
+#ifdef TOOLS_ENABLED
+	// Blocking the main thread would stall a task waiting for its texture extractions.
+	while (batch == &async_batch && Thread::get_caller_id() == async_batch.thread_id && !WorkerThreadPool::get_singleton()->is_task_completed(async_task_id)) {
+		_run_batch_image_extracts(&async_batch);
+		OS::get_singleton()->delay_usec(1000);
+	}
+#endif // TOOLS_ENABLED
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(async_task_id);
+	async_task_id = WorkerThreadPool::INVALID_TASK_ID;
+	async_reporting = false;
+	if (batch == &async_batch) {
+		batch = nullptr;
+	}
+
+	// Release the self reference last, emitting may drop every other one.
+	Ref<FBXDocument> document = async_task.document;
+	async_task.document.unref();
+	if (async_task.generate) {
+		emit_signal(SNAME("scene_generated"), async_task.root);
+	} else {
+		emit_signal(SNAME("append_completed"), async_task.error);
+	}
+}
+
+bool FBXDocument::is_async_task_running() const {
+	return async_task_id != WorkerThreadPool::INVALID_TASK_ID;
+}
+
+float FBXDocument::get_async_progress() const {
+	MutexLock lock(async_mutex);
+	return async_progress;
+}
+
+Error FBXDocument::wait_for_async_task() {
+	if (async_task_id != WorkerThreadPool::INVALID_TASK_ID) {
+		_finish_async_task();
+	}
+	return async_task.error;
+}
+
+void FBXDocument::cancel() {
+	cancel_requested.set();
+}
+
+bool FBXDocument::is_cancel_requested() const {
+	return cancel_requested.is_set();
 }
 
 void FBXDocument::_build_parent_hierarchy(Ref<FBXState> p_state) {
 	// Build the hierarchy.
-	for (FBXNodeIndex node_i = 0; node_i < p_state->nodes.size(); node_i++) {
-		for (int j = 0; j < p_state->nodes[node_i]->children.size(); j++) {
-			FBXNodeIndex child_i = p_state->nodes[node_i]->children[j];
-			ERR_FAIL_INDEX(child_i, p_state->nodes.size());
-			if (p_state->nodes.write[child_i]->parent != -1) {
+	FBXNodeTable &table = p_state->node_table;
+	for (FBXNodeIndex node_i = 0; node_i < table.size(); node_i++) {
+		for (const FBXNodeIndex child_i : table.get_children(node_i)) {
+			ERR_FAIL_INDEX(child_i, table.size());
+			if (table.parents[child_i] != -1) {
 				continue;
 			}
-			p_state->nodes.write[child_i]->parent = node_i;
+			table.parents[child_i] = node_i;
 		}
 	}
 }
 
 Vector<Ref<FBXDocumentExtension>> FBXDocument::all_document_extensions;
+Mutex FBXDocument::all_document_extensions_mutex;
 
 void FBXDocument::register_fbx_document_extension(Ref<FBXDocumentExtension> p_extension, bool p_first_priority) {
+	MutexLock lock(all_document_extensions_mutex);
 	if (all_document_extensions.find(p_extension) == -1) {
 		if (p_first_priority) {
 			all_document_extensions.insert(0, p_extension);
@@ -2655,29 +4696,186 @@ void FBXDocument::register_fbx_document_extension(Ref<FBXDocumentExtension> p_ex
 }
 
 void FBXDocument::unregister_fbx_document_extension(Ref<FBXDocumentExtension> p_extension) {
+	MutexLock lock(all_document_extensions_mutex);
 	all_document_extensions.erase(p_extension);
 }
 
 void FBXDocument::unregister_all_fbx_document_extensions() {
+	MutexLock lock(all_document_extensions_mutex);
 	all_document_extensions.clear();
 }
 
+void FBXDocument::_setup_document_extensions(Ref<FBXState> p_state) {
+	// Each document works on its own copy, so extensions can be registered while other documents import.
+	Vector<Ref<FBXDocumentExtension>> extensions;
+	{
+		MutexLock lock(all_document_extensions_mutex);
+		extensions = all_document_extensions;
+	}
+	document_extensions.clear();
+	document_extension_hooks.clear();
+	document_hooks = 0;
+	for (Ref<FBXDocumentExtension> ext : extensions) {
+		ERR_CONTINUE(ext.is_null());
+		if (ext->import_preflight(p_state, p_state->extensions_used) == OK) {
+			document_extensions.push_back(ext);
+			// Asked once, so hooks nobody implements cost nothing per node.
+			const uint32_t hooks = ext->get_implemented_hooks();
+			document_extension_hooks.push_back(hooks);
+			document_hooks |= hooks;
+		}
+	}
+}
+
+Error FBXDocument::_parse_extension_nodes(Ref<FBXState> p_state) {
+	if (!(document_hooks & (FBXDocumentExtension::HOOK_PARSE_NODES | FBXDocumentExtension::HOOK_PARSE_NODE_EXTENSIONS))) {
+		return OK;
+	}
+	FBXProfileScope profile(p_state.ptr(), "_parse_extension_nodes", "extension");
+	// Extensions work on `FBXNode` views, their changes are written back into the node table.
+	const TypedArray<FBXNode> fbx_nodes = p_state->get_nodes();
+	for (int ext_i = 0; ext_i < document_extensions.size(); ext_i++) {
+		Ref<FBXDocumentExtension> ext = document_extensions[ext_i];
+		const uint32_t hooks = document_extension_hooks[ext_i];
+		if (hooks & FBXDocumentExtension::HOOK_PARSE_NODES) {
+			Error err = ext->parse_nodes(p_state, fbx_nodes);
+			ERR_FAIL_COND_V(err != OK, err);
+		}
+		if (hooks & FBXDocumentExtension::HOOK_PARSE_NODE_EXTENSIONS) {
+			for (Ref<FBXNode> fbx_node : p_state->nodes) {
+				// FBX nodes carry no extension data of their own.
+				Dictionary node_extensions;
+				Error err = ext->parse_node_extensions(p_state, fbx_node, node_extensions);
+				ERR_FAIL_COND_V(err != OK, err);
+			}
+		}
+	}
+	p_state->_apply_node_views();
+	return OK;
+}
+
+void FBXDocument::_generate_extension_scene_nodes(Ref<FBXState> p_state) {
+	if (!(document_hooks & (FBXDocumentExtension::HOOK_GENERATE_SCENE_NODES | FBXDocumentExtension::HOOK_GENERATE_SCENE_NODE))) {
+		return;
+	}
+	FBXProfileScope profile(p_state.ptr(), "_generate_extension_scene_nodes", "extension");
+	// Also brings the views up to date for the per-node hook in `_take_extension_scene_node()`.
+	const TypedArray<FBXNode> fbx_nodes = p_state->get_nodes();
+	for (int ext_i = 0; ext_i < document_extensions.size(); ext_i++) {
+		if (!(document_extension_hooks[ext_i] & FBXDocumentExtension::HOOK_GENERATE_SCENE_NODES)) {
+			continue;
+		}
+		const Dictionary generated = document_extensions[ext_i]->generate_scene_nodes(p_state, fbx_nodes);
+		const Array keys = generated.keys();
+		for (int key_i = 0; key_i < keys.size(); key_i++) {
+			const Variant &key = keys[key_i];
+			Node *node = Object::cast_to<Node>(generated[key]);
+			Node3D *node_3d = Object::cast_to<Node3D>(node);
+			const bool valid_index = key.get_type() == Variant::INT && int(key) >= 0 && int(key) < p_state->node_table.size();
+			// Earlier extensions win, like with `generate_scene_node()`.
+			if (node_3d && valid_index && !extension_scene_nodes.has(int(key))) {
+				extension_scene_nodes.insert(int(key), node_3d);
+				continue;
+			}
+			if (node && !node->get_parent()) {
+				memdelete(node);
+			}
+			ERR_CONTINUE_MSG(!valid_index, "FBX: generate_scene_nodes() returned an invalid node index.");
+			ERR_CONTINUE_MSG(!node_3d, "FBX: generate_scene_nodes() must map node indices to Node3D.");
+		}
+	}
+	profile.set_count(extension_scene_nodes.size());
+}
+
+Node3D *FBXDocument::_take_extension_scene_node(Ref<FBXState> p_state, const FBXNodeIndex p_node_index, Node *p_scene_parent) {
+	HashMap<FBXNodeIndex, Node3D *>::Iterator E = extension_scene_nodes.find(p_node_index);
+	if (E) {
+		Node3D *node = E->value;
+		extension_scene_nodes.remove(E);
+		return node;
+	}
+	if (!(document_hooks & FBXDocumentExtension::HOOK_GENERATE_SCENE_NODE)) {
+		return nullptr;
+	}
+	const Ref<FBXNode> &fbx_node = p_state->nodes[p_node_index];
+	for (int ext_i = 0; ext_i < document_extensions.size(); ext_i++) {
+		if (!(document_extension_hooks[ext_i] & FBXDocumentExtension::HOOK_GENERATE_SCENE_NODE)) {
+			continue;
+		}
+		Node3D *node = document_extensions[ext_i]->generate_scene_node(p_state, fbx_node, p_scene_parent);
+		if (node) {
+			return node;
+		}
+	}
+	return nullptr;
+}
+
+void FBXDocument::_import_extension_nodes(Ref<FBXState> p_state) {
+	if (!(document_hooks & (FBXDocumentExtension::HOOK_IMPORT_NODES | FBXDocumentExtension::HOOK_IMPORT_NODE))) {
+		return;
+	}
+	FBXProfileScope profile(p_state.ptr(), "_import_extension_nodes", "extension");
+	profile.set_count(p_state->scene_nodes.size());
+	p_state->_update_node_views();
+	PackedInt32Array node_indices;
+	TypedArray<Node> nodes;
+	if (document_hooks & FBXDocumentExtension::HOOK_IMPORT_NODES) {
+		node_indices.resize(p_state->scene_nodes.size());
+		nodes.resize(p_state->scene_nodes.size());
+		int i = 0;
+		for (const KeyValue<FBXNodeIndex, Node *> &E : p_state->scene_nodes) {
+			node_indices.set(i, E.key);
+			nodes[i] = E.value;
+			i++;
+		}
+	}
+	for (int ext_i = 0; ext_i < document_extensions.size(); ext_i++) {
+		Ref<FBXDocumentExtension> ext = document_extensions[ext_i];
+		const uint32_t hooks = document_extension_hooks[ext_i];
+		if (hooks & FBXDocumentExtension::HOOK_IMPORT_NODES) {
+			Error err = ext->import_nodes(p_state, node_indices, nodes);
+			ERR_CONTINUE(err != OK);
+		}
+		if (hooks & FBXDocumentExtension::HOOK_IMPORT_NODE) {
+			for (const KeyValue<FBXNodeIndex, Node *> &E : p_state->scene_nodes) {
+				// FBX nodes have no JSON, extensions may still use the dictionary to pass data along.
+				Dictionary node_json;
+				Error err = ext->import_node(p_state, p_state->nodes[E.key], node_json, E.value);
+				ERR_CONTINUE(err != OK);
+			}
+		}
+	}
+}
+
 Node *FBXDocument::generate_scene(Ref<FBXState> p_state, float p_bake_fps, bool p_trimming, bool p_remove_immutable_tracks) {
 	ERR_FAIL_NULL_V(p_state, nullptr);
 	ERR_FAIL_INDEX_V(0, p_state->root_nodes.size(), nullptr);
+	// Nodes edited through `get_nodes()` since the import must reach the animation targets.
+	p_state->_sync_node_views();
 	FBXNodeIndex fbx_root = p_state->root_nodes.write[0];
 	Node *fbx_root_node = p_state->get_scene_node(fbx_root);
 	Node *root = fbx_root_node->get_parent();
 	ERR_FAIL_NULL_V(root, nullptr);
-	_process_mesh_instances(p_state, root);
+	{
+		FBXProfileScope profile(p_state.ptr(), "_process_mesh_instances");
+		_process_mesh_instances(p_state, root);
+		profile.set_count(p_state->scene_mesh_instances.size());
+	}
 	if (p_state->get_create_animations() && p_state->animations.size()) {
+		FBXProfileScope profile(p_state.ptr(), "_import_animation");
+		profile.set_count(p_state->animations.size());
 		AnimationPlayer *ap = memnew(AnimationPlayer);
 		root->add_child(ap, true);
 		ap->set_owner(root);
+		AnimationTargetTable targets;
+		_build_animation_targets(p_state, root, targets);
 		for (int i = 0; i < p_state->animations.size(); i++) {
-			_import_animation(p_state, ap, i, p_bake_fps, p_trimming, p_remove_immutable_tracks);
+			_report_progress(PROGRESS_STAGE_GENERATE, float(i) / float(p_state->animations.size()));
+			FBXProfileScope animation_profile(p_state.ptr(), p_state->animations[i]->get_name(), "animation", true);
+			_import_animation(p_state, ap, i, targets, p_bake_fps, p_trimming, p_remove_immutable_tracks);
 		}
 	}
+	_import_extension_nodes(p_state);
 	ERR_FAIL_NULL_V(root, nullptr);
 	return root;
 }
@@ -2689,20 +4887,35 @@ Error FBXDocument::append_from_buffer(PackedByteArray p_bytes, String p_base_pat
 	p_state->use_named_skin_binds = p_flags & FBX_IMPORT_USE_NAMED_SKIN_BINDS;
 	p_state->discard_meshes_and_materials = p_flags & FBX_IMPORT_DISCARD_MESHES_AND_MATERIALS;
 
-	Ref<FileAccessMemory> file_access;
-	file_access.instantiate();
-	file_access->open_custom(p_bytes.ptr(), p_bytes.size());
 	p_state->base_path = p_base_path.get_base_dir();
-	err = _parse(p_state, p_state->base_path, file_access);
+	cancel_requested.clear();
+	_setup_document_extensions(p_state);
+	err = _parse_buffer(p_state, p_state->base_path, p_bytes);
+	if (err == ERR_SKIP) {
+		return err; // Cancelled.
+	}
 	ERR_FAIL_COND_V(err != OK, err);
 	for (Ref<FBXDocumentExtension> ext : document_extensions) {
 		ERR_CONTINUE(ext.is_null());
 		err = ext->import_post_parse(p_state);
 		ERR_FAIL_COND_V(err != OK, err);
 	}
+	p_state->_sync_node_views();
 	return OK;
 }
 
+// Frees everything only the parse stages read, once the animations are parsed. The meshes,
+// materials, skins and animations hold their own copies, so generating the scene is unaffected.
+void FBXDocument::_release_scene_data(Ref<FBXState> p_state) {
+	FBXProfileScope profile(p_state.ptr(), "_release_scene_data");
+	// Lazy images nothing used by now are never resolved, so they stay null without the scene.
+	p_state->pending_images.clear();
+	p_state->selected_meshes.clear();
+	p_state->selected_materials.clear();
+	p_state->buffers.clear();
+	p_state->scene.reset();
+}
+
 Error FBXDocument::_parse_fbx_state(Ref<FBXState> p_state, const String &p_search_path) {
 	Error err;
 
@@ -2710,61 +4923,223 @@ Error FBXDocument::_parse_fbx_state(Ref<FBXState> p_state, const String &p_searc
 	ERR_FAIL_NULL_V(p_state->scene.get(), ERR_PARSE_ERROR);
 
 	/* PARSE SCENE */
-	err = _parse_scenes(p_state);
+	if (!_report_progress(PROGRESS_STAGE_NODES)) {
+		return ERR_SKIP;
+	}
+	{
+		FBXProfileScope profile(p_state.ptr(), "_parse_scenes");
+		err = _parse_scenes(p_state);
+	}
 	ERR_FAIL_COND_V(err != OK, ERR_PARSE_ERROR);
 
 	/* PARSE NODES */
-	err = _parse_nodes(p_state);
+	{
+		FBXProfileScope profile(p_state.ptr(), "_parse_nodes");
+		err = _parse_nodes(p_state);
+		profile.set_count(p_state->node_table.size());
+	}
 	ERR_FAIL_COND_V(err != OK, ERR_PARSE_ERROR);
+	_select_nodes(p_state);
+	err = _parse_extension_nodes(p_state);
+	ERR_FAIL_COND_V(err != OK, err);
 
 	if (!p_state->discard_meshes_and_materials) {
 		/* PARSE IMAGES */
-		err = _parse_images(p_state, p_search_path);
+		if (!_report_progress(PROGRESS_STAGE_IMAGES)) {
+			return ERR_SKIP;
+		}
+		{
+			FBXProfileScope profile(p_state.ptr(), "_parse_images");
+			err = _parse_images(p_state, p_search_path);
+			profile.set_count(p_state->images.size());
+		}
 
 		ERR_FAIL_COND_V(err != OK, ERR_PARSE_ERROR);
 
 		/* PARSE MATERIALS */
-		err = _parse_materials(p_state);
+		if (!_report_progress(PROGRESS_STAGE_MATERIALS)) {
+			return ERR_SKIP;
+		}
+		{
+			FBXProfileScope profile(p_state.ptr(), "_parse_materials");
+			err = _parse_materials(p_state);
+			profile.set_count(p_state->materials.size());
+		}
+
+		// The materials were the last users of the decoded source images.
+		if (!p_state->keep_source_images || p_state->release_scene_data) {
+			for (Ref<Image> &source_image : p_state->source_images) {
+				source_image.unref();
+			}
+		}
 
 		ERR_FAIL_COND_V(err != OK, ERR_PARSE_ERROR);
 	}
 
 	/* PARSE SKINS */
-	err = _parse_skins(p_state);
+	if (!_report_progress(PROGRESS_STAGE_SKINS)) {
+		return ERR_SKIP;
+	}
+	{
+		FBXProfileScope profile(p_state.ptr(), "_parse_skins");
+		err = _parse_skins(p_state);
+		profile.set_count(p_state->skins.size());
+	}
 	ERR_FAIL_COND_V(err != OK, ERR_PARSE_ERROR);
 
 	/* DETERMINE SKELETONS */
-	err = _determine_skeletons(p_state);
+	{
+		FBXProfileScope profile(p_state.ptr(), "_determine_skeletons");
+		err = _determine_skeletons(p_state);
+		profile.set_count(p_state->skeletons.size());
+	}
 	ERR_FAIL_COND_V(err != OK, ERR_PARSE_ERROR);
 
 	/* CREATE SKELETONS */
-	err = _create_skeletons(p_state);
+	{
+		FBXProfileScope profile(p_state.ptr(), "_create_skeletons");
+		err = _create_skeletons(p_state);
+		profile.set_count(p_state->skeletons.size());
+	}
 	ERR_FAIL_COND_V(err != OK, ERR_PARSE_ERROR);
 
 	/* CREATE SKINS */
-	err = _create_skins(p_state);
+	{
+		FBXProfileScope profile(p_state.ptr(), "_create_skins");
+		err = _create_skins(p_state);
+		profile.set_count(p_state->skins.size());
+	}
 	ERR_FAIL_COND_V(err != OK, ERR_PARSE_ERROR);
 
 	/* PARSE MESHES (we have enough info now) */
-	err = _parse_meshes(p_state);
+	if (!_report_progress(PROGRESS_STAGE_MESHES)) {
+		return ERR_SKIP;
+	}
+	{
+		FBXProfileScope profile(p_state.ptr(), "_parse_meshes");
+		err = _parse_meshes(p_state);
+		profile.set_count(p_state->meshes.size());
+	}
 	ERR_FAIL_COND_V(err != OK, ERR_PARSE_ERROR);
 
 	/* PARSE ANIMATIONS */
-	err = _parse_animations(p_state);
+	if (!_report_progress(PROGRESS_STAGE_ANIMATIONS)) {
+		return ERR_SKIP;
+	}
+	if (p_state->import_animations) {
+		FBXProfileScope profile(p_state.ptr(), "_parse_animations");
+		err = _parse_animations(p_state);
+		profile.set_count(p_state->animations.size());
+	}
 	ERR_FAIL_COND_V(err != OK, ERR_PARSE_ERROR);
 
+	/* RELEASE SCENE DATA */
+	if (p_state->release_scene_data) {
+		_release_scene_data(p_state);
+	}
+
 	/* ASSIGN SCENE NAMES */
+	if (!_report_progress(PROGRESS_STAGE_SCENE)) {
+		return ERR_SKIP;
+	}
+	FBXProfileScope profile(p_state.ptr(), "_generate_scene_node");
 	_assign_node_names(p_state);
+	_determine_multimesh_instances(p_state);
+
+	_generate_extension_scene_nodes(p_state);
 
 	Node3D *root = memnew(Node3D);
 	for (int32_t root_i = 0; root_i < p_state->root_nodes.size(); root_i++) {
 		_generate_scene_node(p_state, p_state->root_nodes[root_i], root, root);
 	}
+	// Bones without meshes and nodes grouped into a MultiMeshInstance3D never take their generated node.
+	for (KeyValue<FBXNodeIndex, Node3D *> &E : extension_scene_nodes) {
+		if (!E.value->get_parent()) {
+			memdelete(E.value);
+		}
+	}
+	extension_scene_nodes.clear();
+	_generate_multimesh_instances(p_state, root);
+	profile.set_count(p_state->scene_nodes.size());
 
 	return OK;
 }
 
 Error FBXDocument::append_from_file(String p_path, Ref<FBXState> p_state, uint32_t p_flags, String p_base_path) {
+	cancel_requested.clear();
+	return _append_from_file(p_path, p_state, p_flags, p_base_path);
+}
+
+PackedInt32Array FBXDocument::append_from_files(const PackedStringArray &p_paths, const TypedArray<FBXState> &p_states, uint32_t p_flags, const String &p_base_path) {
+	PackedInt32Array ret;
+	ERR_FAIL_COND_V_MSG(p_paths.size() != p_states.size(), ret, "FBX: append_from_files() needs one state for each path.");
+	ERR_FAIL_COND_V_MSG(batch, ret, "FBX: append_from_files() can't be called while importing a batch.");
+
+	BatchImport batch_import;
+	batch_import.owner = this;
+	batch_import.thread_id = Thread::get_caller_id();
+	batch_import.flags = p_flags;
+	batch_import.base_path = p_base_path;
+	batch_import.errors.resize(p_paths.size());
+	// States without a cache of their own share one for the whole batch.
+	batch_import.import_cache.instantiate();
+	for (int i = 0; i < p_paths.size(); i++) {
+		Ref<FBXState> state = p_states[i];
+		ERR_FAIL_NULL_V(state, ret);
+		batch_import.paths.push_back(p_paths[i]);
+		batch_import.states.push_back(state);
+	}
+	if (p_paths.is_empty()) {
+		return ret;
+	}
+
+	// Every document calls the same registered extensions, which usually keep the state of the
+	// import they are working on. With any registered, a single task imports the files one at a
+	// time, and only the parse stages of each file run in parallel.
+	bool has_extensions = false;
+	{
+		MutexLock lock(all_document_extensions_mutex);
+		has_extensions = !all_document_extensions.is_empty();
+	}
+
+	cancel_requested.clear();
+	// Low priority, so the group tasks of the parse stages of each file still have threads to run on.
+	WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &FBXDocument::_append_from_files_task, &batch_import, p_paths.size(), has_extensions ? 1 : -1, false, SNAME("FBXAppendFromFiles"));
+	while (!WorkerThreadPool::get_singleton()->is_group_task_completed(group_id)) {
+#ifdef TOOLS_ENABLED
+		_run_batch_image_extracts(&batch_import);
+#endif // TOOLS_ENABLED
+		if (progress_callback.is_valid()) {
+			Variant progress_ret = progress_callback.call(String("Importing files"), float(batch_import.completed.get()) / float(p_paths.size()));
+			// Returning `false` from the callback cancels the files that are still importing.
+			if (progress_ret.get_type() == Variant::BOOL && !bool(progress_ret)) {
+				cancel_requested.set();
+			}
+		}
+		OS::get_singleton()->delay_usec(1000);
+	}
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+
+	ret.resize(p_paths.size());
+	for (int i = 0; i < p_paths.size(); i++) {
+		ret.write[i] = batch_import.errors[i];
+	}
+	return ret;
+}
+
+void FBXDocument::_append_from_files_task(uint32_t p_index, BatchImport *p_batch) {
+	if (cancel_requested.is_set()) {
+		p_batch->errors[p_index] = ERR_SKIP;
+	} else {
+		Ref<FBXDocument> document;
+		document.instantiate();
+		document->batch = p_batch;
+		p_batch->errors[p_index] = document->_append_from_file(p_batch->paths[p_index], p_batch->states[p_index], p_batch->flags, p_batch->base_path);
+	}
+	p_batch->completed.increment();
+}
+
+Error FBXDocument::_append_from_file(String p_path, Ref<FBXState> p_state, uint32_t p_flags, String p_base_path) {
 	ERR_FAIL_COND_V(p_path.is_empty(), ERR_FILE_NOT_FOUND);
 	if (p_state == Ref<FBXState>()) {
 		p_state.instantiate();
@@ -2781,13 +5156,18 @@ Error FBXDocument::append_from_file(String p_path, Ref<FBXState> p_state, uint32
 		base_path = p_path.get_base_dir();
 	}
 	p_state->base_path = base_path;
+	_setup_document_extensions(p_state);
 	err = _parse(p_state, base_path, file);
+	if (err == ERR_SKIP) {
+		return err; // Cancelled.
+	}
 	ERR_FAIL_COND_V(err != OK, err);
 	for (Ref<FBXDocumentExtension> ext : document_extensions) {
 		ERR_CONTINUE(ext.is_null());
 		err = ext->import_post_parse(p_state);
 		ERR_FAIL_COND_V(err != OK, err);
 	}
+	p_state->_sync_node_views();
 	return OK;
 }
 
@@ -33,15 +33,106 @@
 
 #include "extensions/fbx_document_extension.h"
 
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
 #include "modules/modules_enabled.gen.h" // For csg, gridmap.
 
+class FBXArenaAllocator;
+struct FBXImageDecodeJob;
+
 class FBXDocument : public Resource {
 	GDCLASS(FBXDocument, Resource);
 	static Vector<Ref<FBXDocumentExtension>> all_document_extensions;
+	static Mutex all_document_extensions_mutex;
 	Vector<Ref<FBXDocumentExtension>> document_extensions;
+	// Hooks implemented by each of `document_extensions`, and by any of them.
+	LocalVector<uint32_t> document_extension_hooks;
+	uint32_t document_hooks = 0;
+	// Nodes returned by the bulk `generate_scene_nodes()` hooks, waiting for `_generate_scene_node()`.
+	HashMap<FBXNodeIndex, Node3D *> extension_scene_nodes;
 
 private:
-	const float BAKE_FPS = 30.0f;
+	// Stages reported to `progress_callback`, see `_report_progress()`.
+	enum ProgressStage {
+		PROGRESS_STAGE_LOAD,
+		PROGRESS_STAGE_NODES,
+		PROGRESS_STAGE_IMAGES,
+		PROGRESS_STAGE_MATERIALS,
+		PROGRESS_STAGE_SKINS,
+		PROGRESS_STAGE_MESHES,
+		PROGRESS_STAGE_ANIMATIONS,
+		PROGRESS_STAGE_SCENE,
+		PROGRESS_STAGE_GENERATE,
+		PROGRESS_STAGE_MAX,
+	};
+
+	Callable progress_callback;
+	SafeFlag cancel_requested;
+
+	// State of the task started by `append_from_file_async()` or `generate_scene_async()`.
+	struct AsyncTask {
+		Ref<FBXDocument> document; // Keeps the document alive until the task is finished.
+		Ref<FBXState> state;
+		String path;
+		String base_path;
+		uint32_t flags = 0;
+		bool generate = false;
+		float bake_fps = 30.0f;
+		bool trimming = false;
+		bool remove_immutable_tracks = true;
+		Error error = OK;
+		Node *root = nullptr;
+		uint32_t serial = 0; // Matches `async_serial` while this is the current task.
+	};
+
+	// Image extraction a batch worker hands to the thread running the batch, see `_parse_image_save_image()`.
+	struct BatchImageExtract {
+		FBXDocument *document = nullptr;
+		Ref<FBXState> state;
+		const Vector<uint8_t> *bytes = nullptr;
+		String file_extension;
+		int index = -1;
+		Ref<Image> image;
+		String md5;
+		FBXImageIndex slot = -1;
+		FBXImageIndex result = -1;
+		Semaphore done;
+	};
+
+	// State of `append_from_files()`, shared by the documents importing each file.
+	struct BatchImport {
+		FBXDocument *owner = nullptr;
+		Thread::ID thread_id = Thread::UNASSIGNED_ID;
+		Vector<String> paths;
+		Vector<Ref<FBXState>> states;
+		uint32_t flags = 0;
+		String base_path;
+		LocalVector<Error> errors;
+		SafeNumeric<uint32_t> completed;
+		Mutex mutex;
+		LocalVector<BatchImageExtract *> image_extracts;
+		// Used by the states without an import cache of their own, only for this batch.
+		Ref<FBXImportCache> import_cache;
+		// Set for `append_from_file_async()`, whose calling thread doesn't wait in a loop. The
+		// extractions are run by a deferred call on the main thread instead.
+		bool deferred_image_extracts = false;
+	};
+
+	// Set on the documents created by `append_from_files()`, and to `async_batch` while
+	// `append_from_file_async()` runs.
+	BatchImport *batch = nullptr;
+	BatchImport async_batch;
+
+	AsyncTask async_task;
+	WorkerThreadPool::TaskID async_task_id = WorkerThreadPool::INVALID_TASK_ID;
+	uint32_t async_serial = 0;
+	bool async_reporting = false;
+	mutable Mutex async_mutex;
+	float async_progress = 0.0f;
 
 public:
 	const int32_t JOINT_GROUP_SIZE = 4;
@@ -58,12 +149,38 @@ public:
 	static void unregister_fbx_document_extension(Ref<FBXDocumentExtension> p_extension);
 	static void unregister_all_fbx_document_extensions();
 
+	void set_progress_callback(const Callable &p_callback);
+	Callable get_progress_callback() const;
+	void cancel();
+	bool is_cancel_requested() const;
+
+	Error append_from_file_async(String p_path, Ref<FBXState> p_state, uint32_t p_flags = 0, String p_base_path = String());
+	Error generate_scene_async(Ref<FBXState> p_state, float p_bake_fps = 30.0f, bool p_trimming = false, bool p_remove_immutable_tracks = true);
+	bool is_async_task_running() const;
+	float get_async_progress() const;
+	Error wait_for_async_task();
+
 private:
+	bool _report_progress(ProgressStage p_stage, float p_stage_progress = 0.0f);
+	void _wait_for_group_task(WorkerThreadPool::GroupID p_group_id, ProgressStage p_stage, const SafeNumeric<uint32_t> &p_completed, uint32_t p_count);
+	static ufbx_progress_result _load_progress_fn(void *p_user, const ufbx_progress *p_progress);
+	Error _start_async_task();
+	void _run_async_task(AsyncTask *p_task);
+	void _finish_async_task();
+	void _finish_async_task_deferred(uint32_t p_serial);
+	Error _append_from_file(String p_path, Ref<FBXState> p_state, uint32_t p_flags, String p_base_path);
+	void _append_from_files_task(uint32_t p_index, BatchImport *p_batch);
+	void _setup_document_extensions(Ref<FBXState> p_state);
+	Error _parse_extension_nodes(Ref<FBXState> p_state);
+	void _generate_extension_scene_nodes(Ref<FBXState> p_state);
+	Node3D *_take_extension_scene_node(Ref<FBXState> p_state, const FBXNodeIndex p_node_index, Node *p_scene_parent);
+	void _import_extension_nodes(Ref<FBXState> p_state);
 	void _process_uv_set(PackedVector2Array &uv_array);
 	void _zero_unused_elements(Vector<float> &cur_custom, int start, int end, int num_channels);
 	void _build_parent_hierarchy(Ref<FBXState> p_state);
 	Error _parse_scenes(Ref<FBXState> p_state);
 	Error _parse_nodes(Ref<FBXState> p_state);
+	void _select_nodes(Ref<FBXState> p_state);
 	String _gen_unique_name(Ref<FBXState> p_state, const String &p_name);
 	String _sanitize_animation_name(const String &p_name);
 	String _gen_unique_animation_name(Ref<FBXState> p_state, const String &p_name);
@@ -73,15 +190,53 @@ private:
 			const String &p_name);
 	Ref<Texture2D> _get_texture(Ref<FBXState> p_state,
 			const FBXTextureIndex p_texture, int p_texture_type);
+
+	// Surface arrays built for a single ufbx_mesh, before they are added to the ImporterMesh.
+	struct MeshSurface {
+		Mesh::PrimitiveType primitive = Mesh::PRIMITIVE_TRIANGLES;
+		Array arrays;
+		Array morphs;
+		uint32_t flags = 0;
+		uint32_t material_part = 0;
+		bool has_vertex_color = false;
+	};
+
+	struct ParsedMesh {
+		Vector<MeshSurface> surfaces;
+		FBXSkinIndex skin = -1;
+		Error error = OK;
+		FBXState::ProfileEntry profile;
+	};
+
+	struct ParseMeshesTask {
+		const FBXState *state = nullptr;
+		const ufbx_scene *scene = nullptr;
+		Vector<ParsedMesh> meshes;
+		SafeNumeric<uint32_t> completed;
+		bool profile = false;
+	};
+
+	Error _parse_mesh_surfaces(const FBXState *p_state, const ufbx_mesh *p_mesh, ParsedMesh &r_mesh);
+	void _parse_mesh_surfaces_task(uint32_t p_index, ParseMeshesTask *p_task);
 	Error _parse_meshes(Ref<FBXState> p_state);
-	Ref<Image> _parse_image_bytes_into_image(Ref<FBXState> p_state, const Vector<uint8_t> &p_bytes, const String &p_filename, int p_index);
-	FBXImageIndex _parse_image_save_image(Ref<FBXState> p_state, const Vector<uint8_t> &p_bytes, const String &p_file_extension, int p_index, Ref<Image> p_image);
+	FBXImageIndex _store_image(Ref<FBXState> p_state, FBXImageIndex p_slot, const Ref<Texture2D> &p_texture, const Ref<Image> &p_source_image);
+	bool _prepare_image_job(Ref<FBXState> p_state, int p_texture_file, FBXImageDecodeJob &r_job);
+	void _finish_image_job(Ref<FBXState> p_state, int p_texture_file, FBXImageDecodeJob &r_job);
+	void _decode_images(Ref<FBXState> p_state, const LocalVector<int> &p_textures);
+	void _decode_material_images(Ref<FBXState> p_state);
+	void _resolve_image(Ref<FBXState> p_state, FBXImageIndex p_image);
+	FBXImageIndex _parse_image_save_image(Ref<FBXState> p_state, const Vector<uint8_t> &p_bytes, const String &p_file_extension, int p_index, Ref<Image> p_image, const String &p_md5 = String(), FBXImageIndex p_slot = -1);
+#ifdef TOOLS_ENABLED
+	FBXImageIndex _extract_image(Ref<FBXState> p_state, const Vector<uint8_t> &p_bytes, const String &p_file_extension, int p_index, Ref<Image> p_image, const String &p_md5, FBXImageIndex p_slot);
+	void _run_batch_image_extracts(BatchImport *p_batch);
+	void _run_async_image_extracts();
+#endif // TOOLS_ENABLED
 	Error _parse_images(Ref<FBXState> p_state, const String &p_base_path);
 	Error _parse_materials(Ref<FBXState> p_state);
 	FBXNodeIndex _find_highest_node(Ref<FBXState> p_state,
 			const Vector<FBXNodeIndex> &p_subset);
 	void _recurse_children(Ref<FBXState> p_state, const FBXNodeIndex p_node_index,
-			RBSet<FBXNodeIndex> &p_all_skin_nodes, HashSet<FBXNodeIndex> &p_child_visited_set);
+			LocalVector<FBXNodeIndex> &r_all_skin_nodes, LocalVector<int> &r_skin_node_stamps, LocalVector<int> &r_child_visited_stamps, int p_stamp);
 	bool _capture_nodes_in_skin(Ref<FBXState> p_state, Ref<FBXSkin> p_skin,
 			const FBXNodeIndex p_node_index);
 	void _capture_nodes_for_multirooted_skin(Ref<FBXState> p_state, Ref<FBXSkin> p_skin);
@@ -97,9 +252,36 @@ private:
 	Error _create_skeletons(Ref<FBXState> p_state);
 	Error _map_skin_joints_indices_to_skeleton_bone_indices(Ref<FBXState> p_state);
 	Error _create_skins(Ref<FBXState> p_state);
+	uint32_t _get_skin_hash(const Ref<Skin> p_skin);
 	bool _skins_are_same(const Ref<Skin> p_skin_a, const Ref<Skin> p_skin_b);
 	void _remove_duplicate_skins(Ref<FBXState> p_state);
+	void _share_skins(Ref<FBXState> p_state);
+	Ref<FBXImportCache> _get_import_cache(Ref<FBXState> p_state) const;
+
+	struct ParsedAnimation {
+		Ref<FBXAnimation> animation;
+		Error error = OK;
+		String error_message;
+		FBXState::ProfileEntry profile;
+	};
+
+	struct ParseAnimationsTask {
+		const FBXState *state = nullptr;
+		const ufbx_scene *scene = nullptr;
+		LocalVector<uint32_t> anim_stacks; // Indices of the stacks selected by `FBXState::animation_filter`.
+		Vector<ParsedAnimation> animations;
+		SafeNumeric<uint32_t> completed;
+		bool profile = false;
+	};
+
+	Error _parse_animation_stack(const FBXState *p_state, const ufbx_anim_stack *p_anim_stack, ParsedAnimation &r_animation);
+	void _parse_animations_task(uint32_t p_index, ParseAnimationsTask *p_task);
 	Error _parse_animations(Ref<FBXState> p_state);
+	String _get_cache_file(Ref<FBXState> p_state, const String &p_kind, const String &p_options, Vector<uint8_t> &r_key);
+	static bool _load_cached_meshes(const String &p_cache_file, const Vector<uint8_t> &p_key, Vector<ParsedMesh> &r_meshes);
+	static void _save_cached_meshes(const String &p_cache_file, const Vector<uint8_t> &p_key, const Vector<ParsedMesh> &p_meshes);
+	static bool _load_cached_animations(const String &p_cache_file, const Vector<uint8_t> &p_key, Vector<ParsedAnimation> &r_animations);
+	static void _save_cached_animations(const String &p_cache_file, const Vector<uint8_t> &p_key, const Vector<ParsedAnimation> &p_animations);
 	BoneAttachment3D *_generate_bone_attachment(Ref<FBXState> p_state,
 			Skeleton3D *p_skeleton,
 			const FBXNodeIndex p_node_index,
@@ -107,23 +289,54 @@ private:
 	ImporterMeshInstance3D *_generate_mesh_instance(Ref<FBXState> p_state, const FBXNodeIndex p_node_index);
 	Camera3D *_generate_camera(Ref<FBXState> p_state, const FBXNodeIndex p_node_index);
 	Node3D *_generate_spatial(Ref<FBXState> p_state, const FBXNodeIndex p_node_index);
+	void _determine_multimesh_instances(Ref<FBXState> p_state);
+	void _generate_multimesh_instances(Ref<FBXState> p_state, Node *p_scene_root);
 	void _assign_node_names(Ref<FBXState> p_state);
 
 public:
 	Error append_from_file(String p_path, Ref<FBXState> p_state, uint32_t p_flags = 0, String p_base_path = String());
 	Error append_from_buffer(PackedByteArray p_bytes, String p_base_path, Ref<FBXState> p_state, uint32_t p_flags = 0);
+	PackedInt32Array append_from_files(const PackedStringArray &p_paths, const TypedArray<FBXState> &p_states, uint32_t p_flags = 0, const String &p_base_path = String());
 
 public:
 	Node *generate_scene(Ref<FBXState> p_state, float p_bake_fps = 30.0f, bool p_trimming = false, bool p_remove_immutable_tracks = true);
 
 public:
+	void _release_scene_data(Ref<FBXState> p_state);
 	Error _parse_fbx_state(Ref<FBXState> p_state, const String &p_search_path);
 	void _process_mesh_instances(Ref<FBXState> p_state, Node *p_scene_root);
 	void _generate_scene_node(Ref<FBXState> p_state, const FBXNodeIndex p_node_index, Node *p_scene_parent, Node *p_scene_root);
 	void _generate_skeleton_bone_node(Ref<FBXState> p_state, const FBXNodeIndex p_node_index, Node *p_scene_parent, Node *p_scene_root);
+
+	// Animation track targets of a generated scene, shared by every `_import_animation()` call.
+	struct AnimationNodeTarget {
+		bool valid = false;
+		bool animates_transform = false;
+		NodePath transform_path;
+		Vector3 rest_position;
+		Quaternion rest_rotation;
+		Vector3 rest_scale;
+	};
+
+	struct AnimationBlendTarget {
+		int blend_channel = -1;
+		NodePath path;
+	};
+
+	struct AnimationTargetTable {
+		Vector<AnimationNodeTarget> nodes; // Indexed by FBXNodeIndex.
+		Vector<AnimationBlendTarget> blend_shapes;
+	};
+
+	void _build_animation_targets(Ref<FBXState> p_state, Node *p_root, AnimationTargetTable &r_targets);
 	void _import_animation(Ref<FBXState> p_state, AnimationPlayer *p_animation_player,
-			const FBXAnimationIndex p_index, const float p_bake_fps, const bool p_trimming, const bool p_remove_immutable_tracks);
+			const FBXAnimationIndex p_index, const AnimationTargetTable &p_targets, const float p_bake_fps, const bool p_trimming, const bool p_remove_immutable_tracks);
 	Error _parse(Ref<FBXState> p_state, String p_path, Ref<FileAccess> p_file);
+	Error _parse_buffer(Ref<FBXState> p_state, String p_path, const PackedByteArray &p_bytes);
+
+private:
+	void _setup_load_opts(Ref<FBXState> p_state, ufbx_load_opts &r_opts, FBXArenaAllocator *p_temp_arena);
+	Error _parse_loaded_scene(Ref<FBXState> p_state, String p_path, const ufbx_error &p_error);
 };
 
 #endif // FBX_DOCUMENT_H
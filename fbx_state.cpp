@@ -32,6 +32,8 @@
 
 #include "fbx_template_convert.h"
 
+#include "core/io/json.h"
+
 void FBXState::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("add_used_extension", "extension_name", "required"), &FBXState::add_used_extension);
 	ClassDB::bind_method(D_METHOD("get_major_version"), &FBXState::get_major_version);
@@ -72,6 +74,59 @@ void FBXState::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_skeletons", "skeletons"), &FBXState::set_skeletons);
 	ClassDB::bind_method(D_METHOD("get_create_animations"), &FBXState::get_create_animations);
 	ClassDB::bind_method(D_METHOD("set_create_animations", "create_animations"), &FBXState::set_create_animations);
+	ClassDB::bind_method(D_METHOD("get_memory_limit"), &FBXState::get_memory_limit);
+	ClassDB::bind_method(D_METHOD("set_memory_limit", "memory_limit"), &FBXState::set_memory_limit);
+	ClassDB::bind_method(D_METHOD("get_allocation_limit"), &FBXState::get_allocation_limit);
+	ClassDB::bind_method(D_METHOD("set_allocation_limit", "allocation_limit"), &FBXState::set_allocation_limit);
+	ClassDB::bind_method(D_METHOD("get_quantize_skin_weights"), &FBXState::get_quantize_skin_weights);
+	ClassDB::bind_method(D_METHOD("set_quantize_skin_weights", "quantize_skin_weights"), &FBXState::set_quantize_skin_weights);
+	ClassDB::bind_method(D_METHOD("get_bake_fps"), &FBXState::get_bake_fps);
+	ClassDB::bind_method(D_METHOD("set_bake_fps", "bake_fps"), &FBXState::set_bake_fps);
+	ClassDB::bind_method(D_METHOD("get_bake_max_keyframe_segments"), &FBXState::get_bake_max_keyframe_segments);
+	ClassDB::bind_method(D_METHOD("set_bake_max_keyframe_segments", "bake_max_keyframe_segments"), &FBXState::set_bake_max_keyframe_segments);
+	ClassDB::bind_method(D_METHOD("get_bake_key_reduction"), &FBXState::get_bake_key_reduction);
+	ClassDB::bind_method(D_METHOD("set_bake_key_reduction", "bake_key_reduction"), &FBXState::set_bake_key_reduction);
+	ClassDB::bind_method(D_METHOD("get_bake_key_reduction_rotation"), &FBXState::get_bake_key_reduction_rotation);
+	ClassDB::bind_method(D_METHOD("set_bake_key_reduction_rotation", "bake_key_reduction_rotation"), &FBXState::set_bake_key_reduction_rotation);
+	ClassDB::bind_method(D_METHOD("get_bake_key_reduction_threshold"), &FBXState::get_bake_key_reduction_threshold);
+	ClassDB::bind_method(D_METHOD("set_bake_key_reduction_threshold", "bake_key_reduction_threshold"), &FBXState::set_bake_key_reduction_threshold);
+	ClassDB::bind_method(D_METHOD("get_bake_key_reduction_passes"), &FBXState::get_bake_key_reduction_passes);
+	ClassDB::bind_method(D_METHOD("set_bake_key_reduction_passes", "bake_key_reduction_passes"), &FBXState::set_bake_key_reduction_passes);
+	ClassDB::bind_method(D_METHOD("get_compress_animations"), &FBXState::get_compress_animations);
+	ClassDB::bind_method(D_METHOD("set_compress_animations", "compress_animations"), &FBXState::set_compress_animations);
+	ClassDB::bind_method(D_METHOD("get_animation_compression_page_size"), &FBXState::get_animation_compression_page_size);
+	ClassDB::bind_method(D_METHOD("set_animation_compression_page_size", "animation_compression_page_size"), &FBXState::set_animation_compression_page_size);
+	ClassDB::bind_method(D_METHOD("get_import_animations"), &FBXState::get_import_animations);
+	ClassDB::bind_method(D_METHOD("set_import_animations", "import_animations"), &FBXState::set_import_animations);
+	ClassDB::bind_method(D_METHOD("get_animation_filter"), &FBXState::get_animation_filter);
+	ClassDB::bind_method(D_METHOD("set_animation_filter", "animation_filter"), &FBXState::set_animation_filter);
+	ClassDB::bind_method(D_METHOD("get_node_filter"), &FBXState::get_node_filter);
+	ClassDB::bind_method(D_METHOD("set_node_filter", "node_filter"), &FBXState::set_node_filter);
+	ClassDB::bind_method(D_METHOD("get_compress_vertex_attributes"), &FBXState::get_compress_vertex_attributes);
+	ClassDB::bind_method(D_METHOD("set_compress_vertex_attributes", "compress_vertex_attributes"), &FBXState::set_compress_vertex_attributes);
+	ClassDB::bind_method(D_METHOD("get_vertex_compression_max_error"), &FBXState::get_vertex_compression_max_error);
+	ClassDB::bind_method(D_METHOD("set_vertex_compression_max_error", "vertex_compression_max_error"), &FBXState::set_vertex_compression_max_error);
+	ClassDB::bind_method(D_METHOD("get_multimesh_instance_threshold"), &FBXState::get_multimesh_instance_threshold);
+	ClassDB::bind_method(D_METHOD("set_multimesh_instance_threshold", "multimesh_instance_threshold"), &FBXState::set_multimesh_instance_threshold);
+	ClassDB::bind_method(D_METHOD("get_lazy_textures"), &FBXState::get_lazy_textures);
+	ClassDB::bind_method(D_METHOD("set_lazy_textures", "lazy_textures"), &FBXState::set_lazy_textures);
+	ClassDB::bind_method(D_METHOD("get_keep_source_images"), &FBXState::get_keep_source_images);
+	ClassDB::bind_method(D_METHOD("set_keep_source_images", "keep_source_images"), &FBXState::set_keep_source_images);
+	ClassDB::bind_method(D_METHOD("get_release_scene_data"), &FBXState::get_release_scene_data);
+	ClassDB::bind_method(D_METHOD("set_release_scene_data", "release_scene_data"), &FBXState::set_release_scene_data);
+	ClassDB::bind_method(D_METHOD("get_cache_path"), &FBXState::get_cache_path);
+	ClassDB::bind_method(D_METHOD("set_cache_path", "cache_path"), &FBXState::set_cache_path);
+	ClassDB::bind_method(D_METHOD("get_import_cache"), &FBXState::get_import_cache);
+	ClassDB::bind_method(D_METHOD("set_import_cache", "import_cache"), &FBXState::set_import_cache);
+	ClassDB::bind_method(D_METHOD("get_profiling_enabled"), &FBXState::get_profiling_enabled);
+	ClassDB::bind_method(D_METHOD("set_profiling_enabled", "profiling_enabled"), &FBXState::set_profiling_enabled);
+	ClassDB::bind_method(D_METHOD("get_detailed_profiling"), &FBXState::get_detailed_profiling);
+	ClassDB::bind_method(D_METHOD("set_detailed_profiling", "detailed_profiling"), &FBXState::set_detailed_profiling);
+	ClassDB::bind_method(D_METHOD("get_profile"), &FBXState::get_profile);
+	ClassDB::bind_method(D_METHOD("get_profile_as_json"), &FBXState::get_profile_as_json);
+	ClassDB::bind_method(D_METHOD("get_profile_as_chrome_trace"), &FBXState::get_profile_as_chrome_trace);
+	ClassDB::bind_method(D_METHOD("compare_profile", "baseline_json", "tolerance"), &FBXState::compare_profile, DEFVAL(0.1f));
+	ClassDB::bind_method(D_METHOD("clear_profile"), &FBXState::clear_profile);
 	ClassDB::bind_method(D_METHOD("get_animations"), &FBXState::get_animations);
 	ClassDB::bind_method(D_METHOD("set_animations", "animations"), &FBXState::set_animations);
 	ClassDB::bind_method(D_METHOD("get_scene_node", "idx"), &FBXState::get_scene_node);
@@ -99,6 +154,30 @@ void FBXState::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "unique_animation_names", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE | PROPERTY_USAGE_INTERNAL | PROPERTY_USAGE_EDITOR), "set_unique_animation_names", "get_unique_animation_names"); // Set<String>
 	ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "skeletons", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE | PROPERTY_USAGE_INTERNAL | PROPERTY_USAGE_EDITOR), "set_skeletons", "get_skeletons"); // Vector<Ref<FBXSkeleton>>
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "create_animations"), "set_create_animations", "get_create_animations"); // bool
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "memory_limit", PROPERTY_HINT_RANGE, "0,1,1,or_greater,suffix:B"), "set_memory_limit", "get_memory_limit"); // int64_t
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "allocation_limit", PROPERTY_HINT_RANGE, "0,1,1,or_greater"), "set_allocation_limit", "get_allocation_limit"); // int64_t
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "quantize_skin_weights"), "set_quantize_skin_weights", "get_quantize_skin_weights"); // bool
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "bake_fps", PROPERTY_HINT_RANGE, "1,120,0.1,or_greater"), "set_bake_fps", "get_bake_fps"); // double
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "bake_max_keyframe_segments", PROPERTY_HINT_RANGE, "1,256,1,or_greater"), "set_bake_max_keyframe_segments", "get_bake_max_keyframe_segments"); // int
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "bake_key_reduction"), "set_bake_key_reduction", "get_bake_key_reduction"); // bool
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "bake_key_reduction_rotation"), "set_bake_key_reduction_rotation", "get_bake_key_reduction_rotation"); // bool
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "bake_key_reduction_threshold", PROPERTY_HINT_RANGE, "0,1,0.000001,or_greater"), "set_bake_key_reduction_threshold", "get_bake_key_reduction_threshold"); // double
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "bake_key_reduction_passes", PROPERTY_HINT_RANGE, "1,16,1"), "set_bake_key_reduction_passes", "get_bake_key_reduction_passes"); // int
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "compress_animations"), "set_compress_animations", "get_compress_animations"); // bool
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "animation_compression_page_size", PROPERTY_HINT_RANGE, "4,512,1,suffix:kb"), "set_animation_compression_page_size", "get_animation_compression_page_size"); // int
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "import_animations"), "set_import_animations", "get_import_animations"); // bool
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_STRING_ARRAY, "animation_filter"), "set_animation_filter", "get_animation_filter"); // PackedStringArray
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_STRING_ARRAY, "node_filter"), "set_node_filter", "get_node_filter"); // PackedStringArray
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "compress_vertex_attributes"), "set_compress_vertex_attributes", "get_compress_vertex_attributes"); // bool
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "vertex_compression_max_error", PROPERTY_HINT_RANGE, "0,0.1,0.00001,or_greater"), "set_vertex_compression_max_error", "get_vertex_compression_max_error"); // real_t
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "multimesh_instance_threshold", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"), "set_multimesh_instance_threshold", "get_multimesh_instance_threshold"); // int
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "lazy_textures"), "set_lazy_textures", "get_lazy_textures"); // bool
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "keep_source_images"), "set_keep_source_images", "get_keep_source_images"); // bool
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "release_scene_data"), "set_release_scene_data", "get_release_scene_data"); // bool
+	ADD_PROPERTY(PropertyInfo(Variant::STRING, "cache_path", PROPERTY_HINT_GLOBAL_DIR), "set_cache_path", "get_cache_path"); // String
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "import_cache", PROPERTY_HINT_RESOURCE_TYPE, "FBXImportCache", PROPERTY_USAGE_EDITOR), "set_import_cache", "get_import_cache"); // Ref<FBXImportCache>
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "profiling_enabled"), "set_profiling_enabled", "get_profiling_enabled"); // bool
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "detailed_profiling"), "set_detailed_profiling", "get_detailed_profiling"); // bool
 	ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "animations", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE | PROPERTY_USAGE_INTERNAL | PROPERTY_USAGE_EDITOR), "set_animations", "get_animations"); // Vector<Ref<FBXAnimation>>
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "handle_binary_image", PROPERTY_HINT_ENUM, "Discard All Textures,Extract Textures,Embed As Basis Universal,Embed as Uncompressed", PROPERTY_USAGE_STORAGE | PROPERTY_USAGE_INTERNAL | PROPERTY_USAGE_EDITOR), "set_handle_binary_image", "get_handle_binary_image"); // enum
 
@@ -143,12 +222,124 @@ void FBXState::set_use_named_skin_binds(bool p_use_named_skin_binds) {
 	use_named_skin_binds = p_use_named_skin_binds;
 }
 
+FBXNodeIndex FBXNodeTable::push_node() {
+	if (child_offsets.is_empty()) {
+		child_offsets.push_back(0);
+	}
+	const FBXNodeIndex node = parents.size();
+	names.push_back(String());
+	parents.push_back(-1);
+	heights.push_back(-1);
+	meshes.push_back(-1);
+	skins.push_back(-1);
+	skeletons.push_back(-1);
+	joints.push_back(false);
+	positions.push_back(Vector3());
+	rotations.push_back(Quaternion());
+	scales.push_back(Vector3(1, 1, 1));
+	xforms.push_back(Transform3D());
+	child_offsets.push_back(child_indices.size());
+	return node;
+}
+
+void FBXNodeTable::add_child(FBXNodeIndex p_child) {
+	child_indices.push_back(p_child);
+	child_offsets[child_offsets.size() - 1] = child_indices.size();
+}
+
+void FBXNodeTable::clear() {
+	names.clear();
+	parents.clear();
+	heights.clear();
+	meshes.clear();
+	skins.clear();
+	skeletons.clear();
+	joints.clear();
+	positions.clear();
+	rotations.clear();
+	scales.clear();
+	xforms.clear();
+	child_offsets.clear();
+	child_indices.clear();
+}
+
+void FBXState::_update_node_views() {
+	// Views are kept between calls, so their additional data survives.
+	_sync_node_views();
+	const int node_count = node_table.size();
+	nodes.resize(node_count);
+	Ref<FBXNode> *w = nodes.ptrw();
+	for (int i = 0; i < node_count; i++) {
+		if (w[i].is_null()) {
+			w[i].instantiate();
+		}
+		FBXNode *node = w[i].ptr();
+		node->set_name(node_table.names[i]);
+		node->parent = node_table.parents[i];
+		node->height = node_table.heights[i];
+		node->xform = node_table.xforms[i];
+		node->mesh = node_table.meshes[i];
+		node->skin = node_table.skins[i];
+		node->skeleton = node_table.skeletons[i];
+		node->joint = node_table.joints[i];
+		node->position = node_table.positions[i];
+		node->rotation = node_table.rotations[i];
+		node->scale = node_table.scales[i];
+		const FBXNodeTable::Range children = node_table.get_children(i);
+		node->children.resize(children.size());
+		for (int child_i = 0; child_i < children.size(); child_i++) {
+			node->children.write[child_i] = children[child_i];
+		}
+		node->view_dirty = false;
+	}
+}
+
+void FBXState::_apply_node_views() {
+	node_table.clear();
+	for (const Ref<FBXNode> &node : nodes) {
+		ERR_CONTINUE(node.is_null());
+		const FBXNodeIndex node_i = node_table.push_node();
+		node_table.names[node_i] = node->get_name();
+		node_table.parents[node_i] = node->parent;
+		node_table.heights[node_i] = node->height;
+		node_table.xforms[node_i] = node->xform;
+		node_table.meshes[node_i] = node->mesh;
+		node_table.skins[node_i] = node->skin;
+		node_table.skeletons[node_i] = node->skeleton;
+		node_table.joints[node_i] = node->joint;
+		node_table.positions[node_i] = node->position;
+		node_table.rotations[node_i] = node->rotation;
+		node_table.scales[node_i] = node->scale;
+		for (const int child : node->children) {
+			node_table.add_child(child);
+		}
+		node->view_dirty = false;
+	}
+}
+
+// Writes back views that were edited through their setters since they were last updated, so
+// `FBXNode` edits made outside of the parse hooks still reach the node table.
+void FBXState::_sync_node_views() {
+	if (nodes.size() != node_table.size()) {
+		return; // The views are stale, the table was rebuilt since.
+	}
+	for (int i = 0; i < nodes.size(); i++) {
+		const Ref<FBXNode> &node = nodes[i];
+		if (node.is_valid() && (node->view_dirty || node->get_name() != node_table.names[i])) {
+			_apply_node_views();
+			return;
+		}
+	}
+}
+
 TypedArray<FBXNode> FBXState::get_nodes() {
+	_update_node_views(); // Writes back edited views first.
 	return FBXTemplateConvert::to_array(nodes);
 }
 
 void FBXState::set_nodes(TypedArray<FBXNode> p_nodes) {
 	FBXTemplateConvert::set_from_array(nodes, p_nodes);
+	_apply_node_views();
 }
 
 TypedArray<PackedByteArray> FBXState::get_buffers() {
@@ -221,6 +412,7 @@ TypedArray<String> FBXState::get_unique_names() {
 
 void FBXState::set_unique_names(TypedArray<String> p_unique_names) {
 	FBXTemplateConvert::set_from_array(unique_names, p_unique_names);
+	unique_name_counters.clear();
 }
 
 TypedArray<String> FBXState::get_unique_animation_names() {
@@ -229,6 +421,7 @@ TypedArray<String> FBXState::get_unique_animation_names() {
 
 void FBXState::set_unique_animation_names(TypedArray<String> p_unique_animation_names) {
 	FBXTemplateConvert::set_from_array(unique_animation_names, p_unique_animation_names);
+	unique_animation_name_counters.clear();
 }
 
 TypedArray<FBXSkeleton> FBXState::get_skeletons() {
@@ -247,6 +440,330 @@ void FBXState::set_create_animations(bool p_create_animations) {
 	create_animations = p_create_animations;
 }
 
+int64_t FBXState::get_memory_limit() const {
+	return memory_limit;
+}
+
+void FBXState::set_memory_limit(int64_t p_memory_limit) {
+	memory_limit = MAX(p_memory_limit, 0);
+}
+
+int64_t FBXState::get_allocation_limit() const {
+	return allocation_limit;
+}
+
+void FBXState::set_allocation_limit(int64_t p_allocation_limit) {
+	allocation_limit = MAX(p_allocation_limit, 0);
+}
+
+bool FBXState::get_quantize_skin_weights() const {
+	return quantize_skin_weights;
+}
+
+void FBXState::set_quantize_skin_weights(bool p_quantize_skin_weights) {
+	quantize_skin_weights = p_quantize_skin_weights;
+}
+
+double FBXState::get_bake_fps() const {
+	return bake_fps;
+}
+
+void FBXState::set_bake_fps(double p_bake_fps) {
+	ERR_FAIL_COND(p_bake_fps <= 0.0);
+	bake_fps = p_bake_fps;
+}
+
+int FBXState::get_bake_max_keyframe_segments() const {
+	return bake_max_keyframe_segments;
+}
+
+void FBXState::set_bake_max_keyframe_segments(int p_bake_max_keyframe_segments) {
+	ERR_FAIL_COND(p_bake_max_keyframe_segments < 1);
+	bake_max_keyframe_segments = p_bake_max_keyframe_segments;
+}
+
+bool FBXState::get_bake_key_reduction() const {
+	return bake_key_reduction;
+}
+
+void FBXState::set_bake_key_reduction(bool p_bake_key_reduction) {
+	bake_key_reduction = p_bake_key_reduction;
+}
+
+bool FBXState::get_bake_key_reduction_rotation() const {
+	return bake_key_reduction_rotation;
+}
+
+void FBXState::set_bake_key_reduction_rotation(bool p_bake_key_reduction_rotation) {
+	bake_key_reduction_rotation = p_bake_key_reduction_rotation;
+}
+
+double FBXState::get_bake_key_reduction_threshold() const {
+	return bake_key_reduction_threshold;
+}
+
+void FBXState::set_bake_key_reduction_threshold(double p_bake_key_reduction_threshold) {
+	bake_key_reduction_threshold = p_bake_key_reduction_threshold;
+}
+
+int FBXState::get_bake_key_reduction_passes() const {
+	return bake_key_reduction_passes;
+}
+
+void FBXState::set_bake_key_reduction_passes(int p_bake_key_reduction_passes) {
+	ERR_FAIL_COND(p_bake_key_reduction_passes < 1);
+	bake_key_reduction_passes = p_bake_key_reduction_passes;
+}
+
+bool FBXState::get_compress_animations() const {
+	return compress_animations;
+}
+
+void FBXState::set_compress_animations(bool p_compress_animations) {
+	compress_animations = p_compress_animations;
+}
+
+int FBXState::get_animation_compression_page_size() const {
+	return animation_compression_page_size;
+}
+
+void FBXState::set_animation_compression_page_size(int p_animation_compression_page_size) {
+	ERR_FAIL_COND(p_animation_compression_page_size < 4);
+	animation_compression_page_size = p_animation_compression_page_size;
+}
+
+bool FBXState::get_import_animations() const {
+	return import_animations;
+}
+
+void FBXState::set_import_animations(bool p_import_animations) {
+	import_animations = p_import_animations;
+}
+
+PackedStringArray FBXState::get_animation_filter() const {
+	return animation_filter;
+}
+
+void FBXState::set_animation_filter(const PackedStringArray &p_animation_filter) {
+	animation_filter = p_animation_filter;
+}
+
+PackedStringArray FBXState::get_node_filter() const {
+	return node_filter;
+}
+
+void FBXState::set_node_filter(const PackedStringArray &p_node_filter) {
+	node_filter = p_node_filter;
+}
+
+bool FBXState::get_compress_vertex_attributes() const {
+	return compress_vertex_attributes;
+}
+
+void FBXState::set_compress_vertex_attributes(bool p_compress_vertex_attributes) {
+	compress_vertex_attributes = p_compress_vertex_attributes;
+}
+
+real_t FBXState::get_vertex_compression_max_error() const {
+	return vertex_compression_max_error;
+}
+
+void FBXState::set_vertex_compression_max_error(real_t p_vertex_compression_max_error) {
+	ERR_FAIL_COND(p_vertex_compression_max_error < 0.0);
+	vertex_compression_max_error = p_vertex_compression_max_error;
+}
+
+int FBXState::get_multimesh_instance_threshold() const {
+	return multimesh_instance_threshold;
+}
+
+void FBXState::set_multimesh_instance_threshold(int p_multimesh_instance_threshold) {
+	ERR_FAIL_COND(p_multimesh_instance_threshold < 0);
+	multimesh_instance_threshold = p_multimesh_instance_threshold;
+}
+
+bool FBXState::get_lazy_textures() const {
+	return lazy_textures;
+}
+
+void FBXState::set_lazy_textures(bool p_lazy_textures) {
+	lazy_textures = p_lazy_textures;
+}
+
+bool FBXState::get_keep_source_images() const {
+	return keep_source_images;
+}
+
+void FBXState::set_keep_source_images(bool p_keep_source_images) {
+	keep_source_images = p_keep_source_images;
+}
+
+bool FBXState::get_release_scene_data() const {
+	return release_scene_data;
+}
+
+void FBXState::set_release_scene_data(bool p_release_scene_data) {
+	release_scene_data = p_release_scene_data;
+}
+
+String FBXState::get_cache_path() const {
+	return cache_path;
+}
+
+void FBXState::set_cache_path(const String &p_cache_path) {
+	cache_path = p_cache_path;
+}
+
+Ref<FBXImportCache> FBXState::get_import_cache() const {
+	return import_cache;
+}
+
+void FBXState::set_import_cache(const Ref<FBXImportCache> &p_import_cache) {
+	import_cache = p_import_cache;
+}
+
+bool FBXState::get_profiling_enabled() const {
+	return profiling_enabled;
+}
+
+void FBXState::set_profiling_enabled(bool p_profiling_enabled) {
+	profiling_enabled = p_profiling_enabled;
+}
+
+bool FBXState::get_detailed_profiling() const {
+	return detailed_profiling;
+}
+
+void FBXState::set_detailed_profiling(bool p_detailed_profiling) {
+	detailed_profiling = p_detailed_profiling;
+}
+
+void FBXState::add_profile_entry(const ProfileEntry &p_entry) {
+	profile_entries.push_back(p_entry);
+}
+
+TypedArray<Dictionary> FBXState::get_profile() const {
+	TypedArray<Dictionary> ret;
+	for (const ProfileEntry &entry : profile_entries) {
+		Dictionary d;
+		d["name"] = entry.name;
+		d["category"] = entry.category;
+		d["begin_usec"] = entry.begin_usec;
+		d["duration_usec"] = entry.duration_usec;
+		d["thread_id"] = entry.thread_id;
+		d["memory_usage"] = entry.memory_usage;
+		d["memory_peak"] = entry.memory_peak;
+		d["memory_growth"] = entry.memory_growth;
+		if (entry.count >= 0) {
+			d["count"] = entry.count;
+		}
+		if (entry.allocation_count >= 0) {
+			d["allocation_count"] = entry.allocation_count;
+		}
+		ret.push_back(d);
+	}
+	return ret;
+}
+
+String FBXState::get_profile_as_json() const {
+	return JSON::stringify(get_profile(), "\t");
+}
+
+String FBXState::get_profile_as_chrome_trace() const {
+	// Complete ("X") events of the Trace Event Format, loadable in chrome://tracing and Perfetto.
+	Array events;
+	for (const ProfileEntry &entry : profile_entries) {
+		Dictionary args;
+		args["memory_usage"] = entry.memory_usage;
+		args["memory_peak"] = entry.memory_peak;
+		args["memory_growth"] = entry.memory_growth;
+		if (entry.count >= 0) {
+			args["count"] = entry.count;
+		}
+		if (entry.allocation_count >= 0) {
+			args["allocation_count"] = entry.allocation_count;
+		}
+		Dictionary event;
+		event["name"] = entry.name;
+		event["cat"] = entry.category;
+		event["ph"] = "X";
+		event["ts"] = entry.begin_usec;
+		event["dur"] = entry.duration_usec;
+		event["pid"] = 0;
+		event["tid"] = entry.thread_id;
+		event["args"] = args;
+		events.push_back(event);
+	}
+	Dictionary trace;
+	trace["traceEvents"] = events;
+	trace["displayTimeUnit"] = "ms";
+	return JSON::stringify(trace);
+}
+
+// Per-stage totals of a profile, stages entered more than once (one per file appended) are summed.
+struct FBXProfileStageTotals {
+	uint64_t duration_usec = 0;
+	int64_t memory_growth = -1;
+	int64_t allocation_count = -1;
+};
+
+static HashMap<String, FBXProfileStageTotals> _get_profile_stage_totals(const Array &p_entries) {
+	HashMap<String, FBXProfileStageTotals> totals;
+	for (const Variant &entry_variant : p_entries) {
+		const Dictionary entry = entry_variant;
+		if (String(entry.get("category", String())) != "stage") {
+			continue;
+		}
+		FBXProfileStageTotals &stage = totals[String(entry.get("name", String()))];
+		stage.duration_usec += uint64_t(entry.get("duration_usec", 0));
+		if (entry.has("memory_growth")) {
+			stage.memory_growth = MAX(stage.memory_growth, int64_t(entry["memory_growth"]));
+		}
+		if (entry.has("allocation_count")) {
+			stage.allocation_count = MAX(stage.allocation_count, int64_t(0)) + int64_t(entry["allocation_count"]);
+		}
+	}
+	return totals;
+}
+
+static void _compare_profile_value(PackedStringArray &r_regressions, const String &p_stage, const String &p_key, double p_value, double p_baseline, double p_tolerance) {
+	if (p_value > p_baseline * (1.0 + p_tolerance)) {
+		r_regressions.push_back(vformat("%s: %s %d > %d (+%.1f%%)", p_stage, p_key, int64_t(p_value), int64_t(p_baseline), p_baseline > 0.0 ? (p_value / p_baseline - 1.0) * 100.0 : 100.0));
+	}
+}
+
+PackedStringArray FBXState::compare_profile(const String &p_baseline_json, float p_tolerance) const {
+	// Stages faster than this in the baseline are dominated by timer noise, only their memory is compared.
+	static constexpr uint64_t MIN_COMPARED_DURATION_USEC = 1000;
+
+	PackedStringArray regressions;
+	const Variant baseline = JSON::parse_string(p_baseline_json);
+	ERR_FAIL_COND_V_MSG(baseline.get_type() != Variant::ARRAY, regressions, "The baseline must be a profile returned by get_profile_as_json().");
+	const HashMap<String, FBXProfileStageTotals> baseline_totals = _get_profile_stage_totals(baseline);
+	const HashMap<String, FBXProfileStageTotals> totals = _get_profile_stage_totals(get_profile());
+	for (const KeyValue<String, FBXProfileStageTotals> &E : totals) {
+		const FBXProfileStageTotals *baseline_stage = baseline_totals.getptr(E.key);
+		if (!baseline_stage) {
+			continue;
+		}
+		if (baseline_stage->duration_usec >= MIN_COMPARED_DURATION_USEC) {
+			_compare_profile_value(regressions, E.key, "duration_usec", E.value.duration_usec, baseline_stage->duration_usec, p_tolerance);
+		}
+		// Not the process peak, which every stage inherits from whatever ran before it.
+		if (E.value.memory_growth >= 0 && baseline_stage->memory_growth >= 0) {
+			_compare_profile_value(regressions, E.key, "memory_growth", E.value.memory_growth, baseline_stage->memory_growth, p_tolerance);
+		}
+		if (E.value.allocation_count >= 0 && baseline_stage->allocation_count >= 0) {
+			_compare_profile_value(regressions, E.key, "allocation_count", E.value.allocation_count, baseline_stage->allocation_count, p_tolerance);
+		}
+	}
+	return regressions;
+}
+
+void FBXState::clear_profile() {
+	profile_entries.clear();
+}
+
 TypedArray<FBXAnimation> FBXState::get_animations() {
 	return FBXTemplateConvert::to_array(animations);
 }
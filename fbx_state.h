@@ -32,6 +32,7 @@
 #define FBX_STATE_H
 
 #include "structures/fbx_animation.h"
+#include "structures/fbx_import_cache.h"
 #include "structures/fbx_mesh.h"
 #include "structures/fbx_node.h"
 #include "structures/fbx_skeleton.h"
@@ -40,6 +41,50 @@
 
 #include "thirdparty/ufbx/ufbx.h"
 
+// The nodes of a state as columns indexed by FBXNodeIndex, which the import pipeline works on
+// directly. `FBXNode` resources are only views of it for scripts and extensions.
+struct FBXNodeTable {
+	// Contiguous range of node indices, for the children of a node.
+	struct Range {
+		const FBXNodeIndex *from = nullptr;
+		const FBXNodeIndex *to = nullptr;
+
+		const FBXNodeIndex *begin() const { return from; }
+		const FBXNodeIndex *end() const { return to; }
+		int size() const { return int(to - from); }
+		bool is_empty() const { return from == to; }
+		FBXNodeIndex operator[](int p_index) const { return from[p_index]; }
+	};
+
+	LocalVector<String> names;
+	LocalVector<FBXNodeIndex> parents;
+	LocalVector<int> heights;
+	LocalVector<FBXMeshIndex> meshes;
+	LocalVector<FBXSkinIndex> skins;
+	LocalVector<FBXSkeletonIndex> skeletons;
+	LocalVector<bool> joints;
+	LocalVector<Vector3> positions;
+	LocalVector<Quaternion> rotations;
+	LocalVector<Vector3> scales;
+	LocalVector<Transform3D> xforms;
+	// The children of node `i` are `child_indices[child_offsets[i]]` up to `child_indices[child_offsets[i + 1]]`.
+	LocalVector<uint32_t> child_offsets;
+	LocalVector<FBXNodeIndex> child_indices;
+
+	int size() const { return int(parents.size()); }
+	Range get_children(FBXNodeIndex p_node) const {
+		Range range;
+		range.from = child_indices.ptr() + child_offsets[p_node];
+		range.to = child_indices.ptr() + child_offsets[p_node + 1];
+		return range;
+	}
+
+	// Appends a node without children, `add_child()` adds them until the next node is pushed.
+	FBXNodeIndex push_node();
+	void add_child(FBXNodeIndex p_child);
+	void clear();
+};
+
 class FBXState : public Resource {
 	GDCLASS(FBXState, Resource);
 	friend class FBXDocument;
@@ -57,8 +102,63 @@ class FBXState : public Resource {
 	bool discard_meshes_and_materials = false;
 	bool create_animations = true;
 
+	// Limits for the allocations ufbx makes while loading, zero means unlimited.
+	int64_t memory_limit = 0;
+	int64_t allocation_limit = 0;
+
+	bool quantize_skin_weights = false;
+	// Request the compressed vertex format for surfaces whose precision stays within the error.
+	bool compress_vertex_attributes = false;
+	real_t vertex_compression_max_error = 0.001;
+
+	// Selective import, empty filters select everything. Meshes and materials only used by the
+	// nodes outside of `node_filter` are flagged in `selected_meshes`/`selected_materials`.
+	bool import_animations = true;
+	PackedStringArray animation_filter;
+	PackedStringArray node_filter;
+	LocalVector<bool> selected_meshes;
+	LocalVector<bool> selected_materials;
+
+	// Options for `ufbx_bake_anim()`, see `ufbx_bake_opts`.
+	double bake_fps = 30.0;
+	int bake_max_keyframe_segments = 32;
+	bool bake_key_reduction = false;
+	bool bake_key_reduction_rotation = false;
+	double bake_key_reduction_threshold = 0.000001;
+	int bake_key_reduction_passes = 4;
+
+	// Compress every Animation as soon as `_import_animation()` has built it, see `Animation::compress()`.
+	bool compress_animations = false;
+	int animation_compression_page_size = 8;
+
+	// Meshes placed by at least this many static, unskinned nodes are generated as one
+	// MultiMeshInstance3D instead of one node each, zero disables it.
+	int multimesh_instance_threshold = 0;
+	HashMap<FBXMeshIndex, Vector<FBXNodeIndex>> multimesh_instances;
+	HashSet<FBXNodeIndex> multimesh_nodes;
+
+	bool lazy_textures = false;
+	bool keep_source_images = true;
+	// Images that are only decoded once they are first used, with `lazy_textures`.
+	HashSet<FBXImageIndex> pending_images;
+	// Drops the ufbx scene and the parse-only buffers before the scene is generated.
+	bool release_scene_data = false;
+
+	bool profiling_enabled = false;
+	bool detailed_profiling = false;
+
+	// Directory for cached mesh surfaces and baked animations, empty to disable the cache.
+	String cache_path;
+	// MD5 of the source file, only computed when `cache_path` is set.
+	String source_hash;
+	// Absolute path of the source file, empty for buffers. Names its cache files.
+	String source_path;
+	Ref<FBXImportCache> import_cache;
+
 	int handle_binary_image = HANDLE_BINARY_EXTRACT_TEXTURES;
 
+	FBXNodeTable node_table;
+	// Views of `node_table`, only created once scripts or extensions ask for them.
 	Vector<Ref<FBXNode>> nodes;
 	Vector<Vector<uint8_t>> buffers;
 
@@ -83,6 +183,9 @@ class FBXState : public Resource {
 	Vector<FBXSkinIndex> skin_indices;
 	HashSet<String> unique_names;
 	HashSet<String> unique_animation_names;
+	// Last suffix given out for each base name, see `_alloc_unique_name()` in fbx_document.cpp.
+	HashMap<String, int> unique_name_counters;
+	HashMap<String, int> unique_animation_name_counters;
 
 	Vector<Ref<FBXSkeleton>> skeletons;
 	Vector<Ref<FBXAnimation>> animations;
@@ -93,11 +196,37 @@ class FBXState : public Resource {
 	HashMap<ObjectID, HashMap<ObjectID, FBXSkinIndex>> skin_and_skeleton3d_to_fbx_skin;
 	Dictionary additional_data;
 
+public:
+	// Timing and memory of a single import stage, or of a single mesh or animation with detailed profiling.
+	struct ProfileEntry {
+		String name;
+		String category;
+		uint64_t begin_usec = 0;
+		uint64_t duration_usec = 0;
+		uint64_t thread_id = 0;
+		uint64_t memory_usage = 0;
+		uint64_t memory_peak = 0;
+		// How far the stage raised memory above the usage it started with, see `_end_profile_entry()`.
+		uint64_t memory_growth = 0;
+		uint64_t begin_memory_usage = 0;
+		uint64_t begin_memory_peak = 0;
+		int64_t count = -1;
+		int64_t allocation_count = -1;
+	};
+
+private:
+	Vector<ProfileEntry> profile_entries;
+
+	void _update_node_views();
+	void _apply_node_views();
+	void _sync_node_views();
+
 protected:
 	static void _bind_methods();
 
 public:
 	void add_used_extension(const String &p_extension, bool p_required = false);
+	void add_profile_entry(const ProfileEntry &p_entry);
 
 	enum FBXHandleBinary {
 		HANDLE_BINARY_DISCARD_TEXTURES = 0,
@@ -178,6 +307,83 @@ public:
 	bool get_create_animations();
 	void set_create_animations(bool p_create_animations);
 
+	int64_t get_memory_limit() const;
+	void set_memory_limit(int64_t p_memory_limit);
+
+	int64_t get_allocation_limit() const;
+	void set_allocation_limit(int64_t p_allocation_limit);
+
+	bool get_quantize_skin_weights() const;
+	void set_quantize_skin_weights(bool p_quantize_skin_weights);
+
+	double get_bake_fps() const;
+	void set_bake_fps(double p_bake_fps);
+
+	int get_bake_max_keyframe_segments() const;
+	void set_bake_max_keyframe_segments(int p_bake_max_keyframe_segments);
+
+	bool get_bake_key_reduction() const;
+	void set_bake_key_reduction(bool p_bake_key_reduction);
+
+	bool get_bake_key_reduction_rotation() const;
+	void set_bake_key_reduction_rotation(bool p_bake_key_reduction_rotation);
+
+	double get_bake_key_reduction_threshold() const;
+	void set_bake_key_reduction_threshold(double p_bake_key_reduction_threshold);
+
+	int get_bake_key_reduction_passes() const;
+	void set_bake_key_reduction_passes(int p_bake_key_reduction_passes);
+
+	bool get_compress_animations() const;
+	void set_compress_animations(bool p_compress_animations);
+
+	int get_animation_compression_page_size() const;
+	void set_animation_compression_page_size(int p_animation_compression_page_size);
+
+	bool get_import_animations() const;
+	void set_import_animations(bool p_import_animations);
+
+	PackedStringArray get_animation_filter() const;
+	void set_animation_filter(const PackedStringArray &p_animation_filter);
+
+	PackedStringArray get_node_filter() const;
+	void set_node_filter(const PackedStringArray &p_node_filter);
+
+	bool get_compress_vertex_attributes() const;
+	void set_compress_vertex_attributes(bool p_compress_vertex_attributes);
+
+	real_t get_vertex_compression_max_error() const;
+	void set_vertex_compression_max_error(real_t p_vertex_compression_max_error);
+
+	int get_multimesh_instance_threshold() const;
+	void set_multimesh_instance_threshold(int p_multimesh_instance_threshold);
+
+	bool get_lazy_textures() const;
+	void set_lazy_textures(bool p_lazy_textures);
+
+	bool get_keep_source_images() const;
+	void set_keep_source_images(bool p_keep_source_images);
+
+	bool get_release_scene_data() const;
+	void set_release_scene_data(bool p_release_scene_data);
+
+	String get_cache_path() const;
+	void set_cache_path(const String &p_cache_path);
+	Ref<FBXImportCache> get_import_cache() const;
+	void set_import_cache(const Ref<FBXImportCache> &p_import_cache);
+
+	bool get_profiling_enabled() const;
+	void set_profiling_enabled(bool p_profiling_enabled);
+
+	bool get_detailed_profiling() const;
+	void set_detailed_profiling(bool p_detailed_profiling);
+
+	TypedArray<Dictionary> get_profile() const;
+	String get_profile_as_json() const;
+	String get_profile_as_chrome_trace() const;
+	PackedStringArray compare_profile(const String &p_baseline_json, float p_tolerance = 0.1f) const;
+	void clear_profile();
+
 	TypedArray<FBXAnimation> get_animations();
 	void set_animations(TypedArray<FBXAnimation> p_animations);
 
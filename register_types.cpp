@@ -56,6 +56,7 @@ void initialize_fbx_module(ModuleInitializationLevel p_level) {
 		GDREGISTER_CLASS(FBXAnimation);
 		GDREGISTER_CLASS(FBXDocument);
 		GDREGISTER_CLASS(FBXDocumentExtension);
+		GDREGISTER_CLASS(FBXImportCache);
 		GDREGISTER_CLASS(FBXMesh);
 		GDREGISTER_CLASS(FBXNode);
 		GDREGISTER_CLASS(FBXSkeleton);
@@ -0,0 +1,64 @@
+/**************************************************************************/
+/*  fbx_import_cache.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "fbx_import_cache.h"
+
+void FBXImportCache::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("get_external_texture_count"), &FBXImportCache::get_external_texture_count);
+	ClassDB::bind_method(D_METHOD("get_decoded_image_count"), &FBXImportCache::get_decoded_image_count);
+	ClassDB::bind_method(D_METHOD("get_skin_count"), &FBXImportCache::get_skin_count);
+	ClassDB::bind_method(D_METHOD("clear"), &FBXImportCache::clear);
+}
+
+int FBXImportCache::get_external_texture_count() const {
+	MutexLock lock(mutex);
+	return external_textures.size();
+}
+
+int FBXImportCache::get_decoded_image_count() const {
+	MutexLock lock(mutex);
+	return decoded_images.size();
+}
+
+int FBXImportCache::get_skin_count() const {
+	MutexLock lock(mutex);
+	int count = 0;
+	for (const KeyValue<uint32_t, LocalVector<Ref<Skin>>> &E : skins) {
+		count += int(E.value.size());
+	}
+	return count;
+}
+
+void FBXImportCache::clear() {
+	MutexLock lock(mutex);
+	external_textures.clear();
+	decoded_images.clear();
+	skins.clear();
+}
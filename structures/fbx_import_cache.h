@@ -0,0 +1,68 @@
+/**************************************************************************/
+/*  fbx_import_cache.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef FBX_IMPORT_CACHE_H
+#define FBX_IMPORT_CACHE_H
+
+#include "core/io/image.h"
+#include "core/object/ref_counted.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "scene/resources/skin.h"
+#include "scene/resources/texture.h"
+
+// Resources shared by every FBXState that points to the same cache, so that files imported
+// together load external textures, decode identical images and build identical skins once.
+class FBXImportCache : public RefCounted {
+	GDCLASS(FBXImportCache, RefCounted);
+	friend class FBXDocument;
+
+	struct ExternalTexture {
+		Ref<Texture2D> texture; // Null if the file couldn't be loaded as a resource.
+		Ref<Image> image;
+	};
+
+	mutable Mutex mutex;
+	HashMap<String, ExternalTexture> external_textures; // By path.
+	HashMap<String, Ref<Image>> decoded_images; // By MD5 of the encoded data.
+	HashMap<uint32_t, LocalVector<Ref<Skin>>> skins; // By `FBXDocument::_get_skin_hash()`.
+
+protected:
+	static void _bind_methods();
+
+public:
+	int get_external_texture_count() const;
+	int get_decoded_image_count() const;
+	int get_skin_count() const;
+	void clear();
+};
+
+#endif // FBX_IMPORT_CACHE_H
@@ -71,6 +71,7 @@ FBXNodeIndex FBXNode::get_parent() {
 
 void FBXNode::set_parent(FBXNodeIndex p_parent) {
 	parent = p_parent;
+	view_dirty = true;
 }
 
 int FBXNode::get_height() {
@@ -79,6 +80,7 @@ int FBXNode::get_height() {
 
 void FBXNode::set_height(int p_height) {
 	height = p_height;
+	view_dirty = true;
 }
 
 Transform3D FBXNode::get_xform() {
@@ -87,6 +89,7 @@ Transform3D FBXNode::get_xform() {
 
 void FBXNode::set_xform(Transform3D p_xform) {
 	xform = p_xform;
+	view_dirty = true;
 }
 
 FBXMeshIndex FBXNode::get_mesh() {
@@ -95,6 +98,7 @@ FBXMeshIndex FBXNode::get_mesh() {
 
 void FBXNode::set_mesh(FBXMeshIndex p_mesh) {
 	mesh = p_mesh;
+	view_dirty = true;
 }
 
 FBXSkinIndex FBXNode::get_skin() {
@@ -103,6 +107,7 @@ FBXSkinIndex FBXNode::get_skin() {
 
 void FBXNode::set_skin(FBXSkinIndex p_skin) {
 	skin = p_skin;
+	view_dirty = true;
 }
 
 FBXSkeletonIndex FBXNode::get_skeleton() {
@@ -111,6 +116,7 @@ FBXSkeletonIndex FBXNode::get_skeleton() {
 
 void FBXNode::set_skeleton(FBXSkeletonIndex p_skeleton) {
 	skeleton = p_skeleton;
+	view_dirty = true;
 }
 
 Vector3 FBXNode::get_position() {
@@ -119,6 +125,7 @@ Vector3 FBXNode::get_position() {
 
 void FBXNode::set_position(Vector3 p_position) {
 	position = p_position;
+	view_dirty = true;
 }
 
 Quaternion FBXNode::get_rotation() {
@@ -127,6 +134,7 @@ Quaternion FBXNode::get_rotation() {
 
 void FBXNode::set_rotation(Quaternion p_rotation) {
 	rotation = p_rotation;
+	view_dirty = true;
 }
 
 Vector3 FBXNode::get_scale() {
@@ -135,6 +143,7 @@ Vector3 FBXNode::get_scale() {
 
 void FBXNode::set_scale(Vector3 p_scale) {
 	scale = p_scale;
+	view_dirty = true;
 }
 
 Vector<int> FBXNode::get_children() {
@@ -143,6 +152,7 @@ Vector<int> FBXNode::get_children() {
 
 void FBXNode::set_children(Vector<int> p_children) {
 	children = p_children;
+	view_dirty = true;
 }
 
 Variant FBXNode::get_additional_data(const StringName &p_extension_name) {
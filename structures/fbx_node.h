@@ -38,6 +38,7 @@
 class FBXNode : public Resource {
 	GDCLASS(FBXNode, Resource);
 	friend class FBXDocument;
+	friend class FBXState;
 
 private:
 	// matrices need to be transformed to this
@@ -53,6 +54,8 @@ private:
 	Vector3 scale = Vector3(1, 1, 1);
 	Vector<int> children;
 	Dictionary additional_data;
+	// Set by the setters, so `FBXState` knows which views to write back into its node table.
+	bool view_dirty = false;
 
 protected:
 	static void _bind_methods();
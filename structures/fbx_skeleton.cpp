@@ -79,6 +79,7 @@ TypedArray<String> FBXSkeleton::get_unique_names() {
 
 void FBXSkeleton::set_unique_names(TypedArray<String> p_unique_names) {
 	FBXTemplateConvert::set_from_array(unique_names, p_unique_names);
+	unique_name_counters.clear();
 }
 
 Dictionary FBXSkeleton::get_godot_bone_node() {
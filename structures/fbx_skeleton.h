@@ -52,6 +52,8 @@ private:
 
 	// Set of unique bone names for the skeleton
 	HashSet<String> unique_names;
+	// Last suffix given out for each base name.
+	HashMap<String, int> unique_name_counters;
 
 	HashMap<int32_t, FBXNodeIndex> godot_bone_node;
 